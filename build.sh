@@ -10,7 +10,7 @@ fi
 
 echo ">>> Building $contract contract..."
 
-# eosio.cdt v1.6.1
+# eosio.cdt v1.8.1 (action return values)
 # -contract=<string>       - Contract name
 # -o=<string>              - Write output to <file>
 # -abigen                  - Generate ABI
@@ -1,6 +1,10 @@
 //layer name: behaviors
 //required: groups
 
+//NOTE: core behaviors (mint, transfer, activate, reclaim, consume, destroy, freeze) are stored as
+//flags on the group row, custom behaviors are stored in the behaviors table
+//NOTE: groups created before flag storage keep core behavior rows until migrated by migrate_group()
+
 //======================== behavior actions ========================
 
 //add a behavior to a group
@@ -34,3 +38,8 @@ TABLE behavior {
     EOSLIB_SERIALIZE(behavior, (behavior_name)(state)(locked))
 };
 typedef multi_index<name("behaviors"), behavior> behaviors_table;
+
+//======================== behavior functions ========================
+
+//get the flag for a core behavior (returns 0 for custom behaviors)
+uint8_t core_behavior_flag(name behavior_name);
@@ -28,11 +28,22 @@ TABLE config {
     string contract_name;
     string contract_version;
     name admin;
-    uint64_t last_serial;
+    uint64_t last_serial; //legacy serial counter, seeds the serials table on upgrade
     //uint64_t last_locker_id;
     //symbol core_sym;
     //vector<name> installed; //name of layers installed on marble factory
 
     EOSLIB_SERIALIZE(config, (contract_name)(contract_version)(admin)(last_serial))
 };
-typedef singleton<name("config"), config> config_table;
\ No newline at end of file
+typedef singleton<name("config"), config> config_table;
+
+//serials table
+//NOTE: created by init(), or from config last_serial by the first reservation after upgrade
+//scope: self
+//ram payer: contract
+TABLE serial_counter {
+    uint64_t last_serial; //last serial reserved by any group
+
+    EOSLIB_SERIALIZE(serial_counter, (last_serial))
+};
+typedef singleton<name("serials"), serial_counter> serials_table;
\ No newline at end of file
@@ -15,8 +15,17 @@ ACTION editgroup(name group_name, string new_title, string new_description);
 //auth: manager
 ACTION setmanager(name group_name, name new_manager, string memo);
 
+//move a group written before flag storage onto the extended group row
+//NOTE: folds core behavior rows into group flags and erases them
+//auth: admin
+ACTION migrategroup(name group_name);
+
 //======================== group tables ========================
 
+//groups table
+//NOTE: extension fields are empty on rows written before flag storage until the group is migrated
+//scope: self
+//ram payer: contract
 TABLE group {
     string title;
     string description;
@@ -25,10 +34,22 @@ TABLE group {
     uint64_t supply;
     uint64_t issued_supply;
     uint64_t supply_cap;
+    binary_extension<uint8_t> behavior_states; //core behavior on/off flags
+    binary_extension<uint8_t> behavior_locks; //core behavior lock flags
+    binary_extension<uint64_t> next_serial; //next serial in reserved block
+    binary_extension<uint64_t> serials_left; //serials left in reserved block
+    binary_extension<uint8_t> options; //layer option flags
 
     uint64_t primary_key() const { return group_name.value; }
 
     EOSLIB_SERIALIZE(group, (title)(description)(group_name)(manager)
-        (supply)(issued_supply)(supply_cap))
+        (supply)(issued_supply)(supply_cap)(behavior_states)(behavior_locks)
+        (next_serial)(serials_left)(options))
 };
-typedef multi_index<name("groups"), group> groups_table;
\ No newline at end of file
+typedef multi_index<name("groups"), group> groups_table;
+
+//======================== group functions ========================
+
+//fill the extension fields of a group row written before flag storage, no-op if already migrated
+//NOTE: must run before any write to a group row that may predate flag storage
+void migrate_group(groups_table& groups, const group& grp);
\ No newline at end of file
@@ -7,6 +7,10 @@
 //auth: manager
 ACTION mintitem(name to, name group_name);
 
+//mint a batch of new items with contiguous serials
+//auth: manager
+ACTION mintitems(name to, name group_name, uint64_t count);
+
 //transfer ownership of one or more items
 //auth: owner
 ACTION transferitem(name from, name to, vector<uint64_t> serials, string memo);
@@ -20,15 +24,32 @@ ACTION activateitem(uint64_t serial);
 ACTION reclaimitem(uint64_t serial);
 
 //consume an item
-//post: inline releaseall() if bond(s) exist
+//post: bond settled to item owner wallet if bond exists
 //auth: owner
 ACTION consumeitem(uint64_t serial);
 
 //destroy an item
-//post: inline releaseall() if bond(s) exist
+//post: bond settled to item owner wallet if bond exists
 //auth: manager
 ACTION destroyitem(uint64_t serial, string memo);
 
+//consume a batch of items
+//post: bond amounts credited to owner wallet once
+//auth: owner
+ACTION consumeitems(name owner, vector<uint64_t> serials);
+
+//destroy a batch of items
+//post: bond amounts credited once per owner wallet
+//auth: manager of each group
+ACTION destroyitems(vector<uint64_t> serials, string memo);
+
+//erase up to max_rows orphaned tags, attributes, and events from a consumed or destroyed item
+//NOTE: also reclaims rows orphaned before purge queueing, any serial without an item row is accepted
+//pre: item does not exist
+//post: item removed from purges table when no rows remain
+//auth: none
+ACTION purgeitem(uint64_t serial, uint16_t max_rows);
+
 //freeze an item to prevent transfer, activate, consume, reclaim, or destroy
 //auth: manager
 // ACTION freezeitem(uint64_t serial);
@@ -46,15 +67,141 @@ TABLE item {
     uint64_t serial;
     name group;
     name owner;
+    binary_extension<name> frame; //frame item inherits defaults from (blank or empty if none)
     //uint64_t mint; //edition?
 
     uint64_t primary_key() const { return serial; }
     uint64_t by_group() const { return group.value; }
     uint64_t by_owner() const { return owner.value; }
+    uint128_t by_owner_group() const { return (uint128_t(owner.value) << 64) | group.value; }
 
-    EOSLIB_SERIALIZE(item, (serial)(group)(owner))
+    EOSLIB_SERIALIZE(item, (serial)(group)(owner)(frame))
 };
 typedef multi_index<name("items"), item,
     indexed_by<"bygroup"_n, const_mem_fun<item, uint64_t, &item::by_group>>,
-    indexed_by<"byowner"_n, const_mem_fun<item, uint64_t, &item::by_owner>>
+    indexed_by<"byowner"_n, const_mem_fun<item, uint64_t, &item::by_owner>>,
+    indexed_by<"byownergrp"_n, const_mem_fun<item, uint128_t, &item::by_owner_group>>
 > items_table;
+
+//purges table
+//scope: self
+//ram payer: contract
+TABLE purge {
+    uint64_t serial; //serial of erased item with orphaned layer rows
+
+    uint64_t primary_key() const { return serial; }
+
+    EOSLIB_SERIALIZE(purge, (serial))
+};
+typedef multi_index<name("purges"), purge> purges_table;
+
+//======================== item functions ========================
+
+//reserve serials for new items in a group and update group supply, returns first serial
+//NOTE: draws from the group's serial block, reserves a new block from the serials table when exhausted
+uint64_t reserve_serials(groups_table& groups, const group& grp, uint64_t count);
+
+//queue an erased item for purging if it left any tags, attributes, or events behind
+void queue_purge(uint64_t serial);
+
+//======================== item queries ========================
+
+//inventory entry
+struct inventory_entry {
+    uint64_t serial;
+    name group;
+
+    EOSLIB_SERIALIZE(inventory_entry, (serial)(group))
+};
+
+//inventory page
+struct inventory_page {
+    vector<inventory_entry> items;
+    name next_group; //group of last returned item
+    uint64_t next_cursor; //last returned serial to resume after (0 if no more items)
+
+    EOSLIB_SERIALIZE(inventory_page, (items)(next_group)(next_cursor))
+};
+
+//get a page of items owned by an account, filtered by group (blank group for all groups)
+//pre: cursor_group and cursor are blank and 0, or returned in next_group and next_cursor
+//post: read only, call with a dry run to read the return value
+//NOTE: resumes after the cursor even if the cursor item has since been transferred or erased
+//auth: none
+[[eosio::action]] inventory_page getinventory(name owner, name group_name, name cursor_group, uint64_t cursor, uint16_t limit);
+
+//resolved tag
+struct tag_view {
+    name tag_name;
+    string content;
+    string checksum;
+    string algorithm;
+    bool locked;
+    bool shared; //true if read from group shared tags
+
+    EOSLIB_SERIALIZE(tag_view, (tag_name)(content)(checksum)(algorithm)(locked)(shared))
+};
+
+//resolved attribute
+struct attribute_view {
+    name attribute_name;
+    int64_t points;
+    bool locked;
+    bool shared; //true if read from group shared attributes
+
+    EOSLIB_SERIALIZE(attribute_view, (attribute_name)(points)(locked)(shared))
+};
+
+//resolved event
+struct event_view {
+    name event_name;
+    time_point_sec event_time;
+    bool locked;
+    bool shared; //true if read from group shared events
+
+    EOSLIB_SERIALIZE(event_view, (event_name)(event_time)(locked)(shared))
+};
+
+//bond on an item
+struct bond_view {
+    asset backed_amount;
+    name release_event;
+    bool locked;
+    time_point_sec start_time;
+    uint32_t step_period;
+    uint16_t steps;
+    uint16_t claimed_steps;
+    asset per_step;
+
+    EOSLIB_SERIALIZE(bond_view, (backed_amount)(release_event)(locked)
+        (start_time)(step_period)(steps)(claimed_steps)(per_step))
+};
+
+//fully resolved item
+struct item_view {
+    uint64_t serial;
+    name group;
+    name owner;
+    name frame;
+    vector<tag_view> tags;
+    vector<attribute_view> attributes;
+    vector<event_view> events;
+    vector<bond_view> bonds;
+
+    EOSLIB_SERIALIZE(item_view, (serial)(group)(owner)(frame)(tags)(attributes)(events)(bonds))
+};
+
+//item view page
+struct item_view_page {
+    vector<item_view> items;
+    uint16_t next_cursor; //index into serials to resume from (0 if no more items)
+
+    EOSLIB_SERIALIZE(item_view_page, (items)(next_cursor))
+};
+
+//get resolved items with all layers, item values override frame defaults which override shared values
+//NOTE: serials not found are skipped, a page ends after MAX_VIEW_ITEMS items or MAX_VIEW_BYTES of serialized item views
+//pre: cursor is 0 or an index returned in next_cursor
+//post: read only, call with a dry run to read the return value
+//auth: none
+[[eosio::action]] item_view_page getitems(vector<uint64_t> serials, uint16_t cursor);
@@ -27,6 +27,33 @@ ACTION lockattr(uint64_t serial, name attribute_name, bool shared);
 //auth: manager
 ACTION rmvattribute(uint64_t serial, name group_name, name attribute_name, bool shared);
 
+//attribute delta
+struct attribute_delta {
+    uint64_t serial;
+    name attribute_name;
+    int64_t delta; //signed points to add
+    bool shared; //if true delta applies to the item group's shared attribute
+
+    EOSLIB_SERIALIZE(attribute_delta, (serial)(attribute_name)(delta)(shared))
+};
+
+//apply a batch of signed point deltas, summing repeats so each touched row is written once
+//auth: manager of each group touched
+ACTION applydeltas(vector<attribute_delta> deltas);
+
+//set the attribute storage layout for a group's items
+//pre: group has never issued an item
+//auth: manager
+ACTION setattrmode(name group_name, bool packed);
+
+//register an attribute for ranking, item points are indexed as they are written
+//auth: manager
+ACTION rankattr(name group_name, name attribute_name);
+
+//index current points of existing items for a ranked attribute, including inherited frame defaults
+//auth: none
+ACTION syncranks(name group_name, name attribute_name, vector<uint64_t> serials);
+
 //======================== attribute tables ========================
 
 //attributes table
@@ -56,3 +83,146 @@ TABLE shared_attribute {
     EOSLIB_SERIALIZE(shared_attribute, (attribute_name)(points)(locked))
 };
 typedef multi_index<name("sharedattrs"), shared_attribute> shared_attributes_table;
+
+//packed attribute
+struct packed_attribute {
+    name attribute_name;
+    int64_t points;
+
+    EOSLIB_SERIALIZE(packed_attribute, (attribute_name)(points))
+};
+
+//attribute packs table
+//NOTE: used instead of the attributes table by groups with PACKED_ATTRS_OPT
+//scope: self
+//ram payer: contract
+TABLE attribute_pack {
+    uint64_t serial;
+    vector<packed_attribute> attributes; //sorted by attribute name
+    vector<uint8_t> lock_bits; //bit i set if attributes[i] is locked
+
+    uint64_t primary_key() const { return serial; }
+
+    //binary search for attribute, returns attributes.size() if not found
+    size_t index_of(name attribute_name) const {
+        auto itr = lower_bound(attributes.begin(), attributes.end(), attribute_name,
+            [](const packed_attribute& pa, name n) { return pa.attribute_name < n; });
+        return (itr != attributes.end() && itr->attribute_name == attribute_name) ? itr - attributes.begin() : attributes.size();
+    }
+
+    bool is_locked(size_t index) const { return lock_bits[index / 8] & (1 << (index % 8)); }
+
+    void set_locked(size_t index, bool locked) {
+        if (locked) {
+            lock_bits[index / 8] |= (1 << (index % 8));
+        } else {
+            lock_bits[index / 8] &= ~(1 << (index % 8));
+        }
+    }
+
+    //insert attribute in sorted position, returns its index
+    size_t insert(name attribute_name, int64_t points) {
+        auto itr = lower_bound(attributes.begin(), attributes.end(), attribute_name,
+            [](const packed_attribute& pa, name n) { return pa.attribute_name < n; });
+        size_t index = itr - attributes.begin();
+        attributes.insert(itr, {attribute_name, points});
+        lock_bits.resize((attributes.size() + 7) / 8, 0);
+        for (size_t i = attributes.size() - 1; i > index; i--) {
+            set_locked(i, is_locked(i - 1));
+        }
+        set_locked(index, false);
+        return index;
+    }
+
+    void erase(size_t index) {
+        for (size_t i = index; i + 1 < attributes.size(); i++) {
+            set_locked(i, is_locked(i + 1));
+        }
+        set_locked(attributes.size() - 1, false);
+        attributes.erase(attributes.begin() + index);
+        lock_bits.resize((attributes.size() + 7) / 8);
+    }
+
+    EOSLIB_SERIALIZE(attribute_pack, (serial)(attributes)(lock_bits))
+};
+typedef multi_index<name("attrpacks"), attribute_pack> attribute_packs_table;
+
+//ranked attributes table
+//scope: group
+//ram payer: contract
+TABLE ranked_attribute {
+    name attribute_name;
+
+    uint64_t primary_key() const { return attribute_name.value; }
+
+    EOSLIB_SERIALIZE(ranked_attribute, (attribute_name))
+};
+typedef multi_index<name("rankedattrs"), ranked_attribute> ranked_attributes_table;
+
+//ranks table
+//scope: group
+//ram payer: contract
+TABLE rank {
+    uint64_t rank_id;
+    uint64_t serial;
+    name attribute_name;
+    int64_t points;
+
+    uint64_t primary_key() const { return rank_id; }
+    //points biased to unsigned so the index sorts in signed order
+    uint128_t by_points() const { return (uint128_t(attribute_name.value) << 64) | (uint64_t(points) ^ (uint64_t(1) << 63)); }
+    uint128_t by_item() const { return (uint128_t(serial) << 64) | attribute_name.value; }
+
+    EOSLIB_SERIALIZE(rank, (rank_id)(serial)(attribute_name)(points))
+};
+typedef multi_index<name("ranks"), rank,
+    indexed_by<"bypoints"_n, const_mem_fun<rank, uint128_t, &rank::by_points>>,
+    indexed_by<"byitem"_n, const_mem_fun<rank, uint128_t, &rank::by_item>>
+> ranks_table;
+
+//======================== attribute functions ========================
+
+//item attribute read from either storage layout or from the item's frame
+struct attribute_slot {
+    int64_t points;
+    bool locked;
+    bool stored; //false if inherited from frame
+};
+
+//get an item attribute from the group's storage layout, falling back to the item's inherited frame
+optional<attribute_slot> get_item_attribute(const item& itm, const group& grp, name attribute_name);
+
+//create or update an item attribute in the group's storage layout
+void put_item_attribute(uint64_t serial, const group& grp, name attribute_name, int64_t points, bool locked);
+
+//erase an item attribute from the group's storage layout, returns false if not stored
+bool erase_item_attribute(uint64_t serial, const group& grp, name attribute_name);
+
+//update the rank of an item attribute if ranked in group, falls back to inherited points if points is empty
+void sync_rank(const group& grp, uint64_t serial, name attribute_name, optional<int64_t> points);
+
+//erase all ranks of an item
+//pre: item group has RANKED_ATTRS_OPT
+void clear_ranks(name group_name, uint64_t serial);
+
+//add signed points, fails on overflow
+int64_t add_points(int64_t points, int64_t delta);
+
+//write the attributes of a newly minted item in the group's storage layout
+//pre: item has no attributes
+void emplace_item_attributes(uint64_t serial, const group& grp, const map<name, int64_t>& attributes);
+
+//======================== attribute queries ========================
+
+//ranked item
+struct rank_entry {
+    uint64_t serial;
+    int64_t points;
+
+    EOSLIB_SERIALIZE(rank_entry, (serial)(points))
+};
+
+//get items ranked by attribute points in descending order, within a points range
+//post: read only, call with a dry run to read the return value
+//auth: none
+[[eosio::action]] vector<rank_entry> getranks(name group_name, name attribute_name, int64_t min_points, int64_t max_points, uint16_t limit);
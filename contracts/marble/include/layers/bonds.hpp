@@ -4,29 +4,54 @@
 //======================== bond actions ========================
 
 //back an item with a fungible token (draws from manager wallet balance)
+//NOTE: release event is read from item events, then from group shared events
 //auth: manager
 ACTION newbond(uint64_t serial, asset amount, optional<name> release_event);
 
+//back many items with the same amount in one manager wallet debit
+//pre: all item groups have the same manager
+//auth: manager
+ACTION newbonds(vector<uint64_t> serials, asset per_item, optional<name> release_event);
+
 //add more tokens to an existing bond
 //pre: bond exists, bond not locked
 //auth: manager
 ACTION addtobond(uint64_t serial, asset amount);
 
-//release preconfigured amount from item bond
-//pre: item exists, release conditions met
+//back an item with a fungible token released in equal steps (draws from manager wallet balance)
+//NOTE: amount / steps is released each step_period after start time, the final step releases the remainder
+//auth: manager
+ACTION newvesting(uint64_t serial, asset amount, uint16_t steps, uint32_t step_period, optional<time_point_sec> start_time);
+
+//release matured amounts from all item bonds
+//pre: item exists, release conditions met for at least one bond
 //auth: item owner
 ACTION release(uint64_t serial);
 
+//release matured amounts from many item bonds into one wallet credit
+//pre: owner owns all items, release conditions met for at least one bond
+//auth: owner
+ACTION releasemany(name owner, vector<uint64_t> serials);
+
 //release all bond amounts from an item
 //pre: item consumed or destroyed, release_to == item.owner
 //auth: contract (inline)
 ACTION releaseall(uint64_t serial, name release_to);
 
-//locks a bond to prevent settings changes
+//locks the core currency bond to prevent settings changes
 //pre: bond not locked
 //auth: manager
 ACTION lockbond(uint64_t serial);
 
+//locks a bond of any currency to prevent settings changes
+//pre: bond not locked
+//auth: manager
+ACTION lockbondsym(uint64_t serial, symbol_code bond_sym);
+
+//release up to max due bonds in release time order to item owners
+//auth: none
+ACTION crank(uint16_t max);
+
 //======================== bond tables ========================
 
 //bonds table
@@ -36,13 +61,75 @@ TABLE bond {
     asset backed_amount; //token amount stored by bond
     name release_event; //event name storing release time (blank for no release time)
     bool locked; //if true bond settings cannot be changed
-
-    // asset per_release; //amount released from bond per release event
-    // uint16_t steps; //number of release steps before maturity
-    // asset per_step; //amount released from bond per step
+    binary_extension<time_point_sec> start_time; //vesting start time
+    binary_extension<uint32_t> step_period; //seconds between vesting steps
+    binary_extension<uint16_t> steps; //number of release steps before maturity (0 or empty if not vesting)
+    binary_extension<uint16_t> claimed_steps; //number of steps already released
+    binary_extension<asset> per_step; //amount released from bond per step
 
     uint64_t primary_key() const { return backed_amount.symbol.code().raw(); }
 
-    EOSLIB_SERIALIZE(bond, (backed_amount)(release_event)(locked))
+    EOSLIB_SERIALIZE(bond, (backed_amount)(release_event)(locked)
+        (start_time)(step_period)(steps)(claimed_steps)(per_step))
 };
 typedef multi_index<name("bonds"), bond> bonds_table;
+
+//releases table
+//NOTE: index of bonds with a release event, ordered by release time
+//scope: self
+//ram payer: contract
+TABLE bond_release {
+    uint64_t release_id;
+    uint64_t serial;
+    symbol_code bond_sym; //symbol code of released bond
+    time_point_sec release_time; //time of bond release event
+
+    uint64_t primary_key() const { return release_id; }
+    uint128_t by_time() const { return (uint128_t(release_time.sec_since_epoch()) << 64) | serial; }
+    uint128_t by_bond() const { return (uint128_t(serial) << 64) | bond_sym.raw(); }
+
+    EOSLIB_SERIALIZE(bond_release, (release_id)(serial)(bond_sym)(release_time))
+};
+typedef multi_index<name("releases"), bond_release,
+    indexed_by<"bytime"_n, const_mem_fun<bond_release, uint128_t, &bond_release::by_time>>,
+    indexed_by<"bybond"_n, const_mem_fun<bond_release, uint128_t, &bond_release::by_bond>>
+> releases_table;
+
+//======================== bond functions ========================
+
+//add or move a bond in the release index
+void index_release(uint64_t serial, symbol_code bond_sym, time_point_sec release_time);
+
+//remove a bond from the release index if indexed
+void unindex_release(uint64_t serial, symbol_code bond_sym);
+
+//erase a bond and its release index entry, returns the backed amount
+asset take_bond(uint64_t serial, bonds_table& bonds, bonds_table::const_iterator bond_itr);
+
+//get the time of a bond release event from item events, falling back to group shared events
+optional<time_point_sec> get_release_time(uint64_t serial, name group_name, name release_event);
+
+//get the time of a bond release event from item events, falling back to a shared event time already looked up
+optional<time_point_sec> get_release_time(uint64_t serial, name release_event, optional<time_point_sec> shared_time);
+
+//get the time of a group shared event used as a bond release event
+optional<time_point_sec> get_shared_release_time(name group_name, name release_event);
+
+//get indexed releases of group bonds released by a shared event, skipping items with an overriding item event
+vector<bond_release> shared_releases(name group_name, name release_event, time_point_sec event_time);
+
+//release the matured amount of a bond, erasing it when fully released, returns the released amount
+//NOTE: returns a zero amount if nothing has matured
+asset claim_bond(const item& itm, bonds_table& bonds, bonds_table::const_iterator bond_itr, time_point_sec now);
+
+//release matured amounts of all item bonds, adding them to totals by bond symbol
+void claim_bonds(const item& itm, time_point_sec now, map<symbol_code, asset>& totals);
+
+//erase all item bonds and release index entries, adding backed amounts to totals by bond symbol
+void take_bonds(uint64_t serial, map<symbol_code, asset>& totals);
+
+//add to an item bond, creating it if not found, from a transfer by the group manager
+void fund_bond(uint64_t serial, asset amount, name funder);
+
+//settle all item bonds into wallets
+void settle_bonds(uint64_t serial, name release_to);
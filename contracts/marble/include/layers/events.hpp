@@ -23,6 +23,14 @@ ACTION rmvevent(uint64_t serial, name group_name, name event_name, bool shared);
 //auth: self
 ACTION logevent(name event_name, int64_t event_value, time_point_sec event_time, string memo, bool shared);
 
+//log an event for a range of serials (will not save to events table)
+//auth: self
+ACTION logrange(name event_name, name group_name, uint64_t first_serial, uint64_t last_serial, time_point_sec event_time);
+
+//set how item events are emitted for a group (inline by default, aggregate, or off)
+//auth: manager
+ACTION setemitmode(name group_name, name mode);
+
 //======================== event tables ========================
 
 //events table
@@ -52,3 +60,12 @@ TABLE shared_event {
     EOSLIB_SERIALIZE(shared_event, (event_name)(event_time)(locked))
 };
 typedef multi_index<name("sharedevents"), shared_event> shared_events_table;
+
+//======================== event functions ========================
+
+//emit an event for a single item in the group's emission mode
+void emit_event(const group& grp, name event_name, uint64_t serial, string memo);
+
+//emit one summary event for consecutive serials from a batch action
+//NOTE: batch actions always emit a logrange unless emission is off
+void emit_range(const group& grp, name event_name, uint64_t first_serial, uint64_t count);
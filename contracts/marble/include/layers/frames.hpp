@@ -7,7 +7,13 @@
 //auth: manager
 ACTION newframe(name frame_name, name group, map<name, string> default_tags, map<name, int64_t> default_attributes);
 
-//applies a frame to an item
+//enable copy-on-write inheritance on a frame (framed items link to the frame instead of copying defaults)
+//pre: frame not inherited
+//post: frame can no longer be removed
+//auth: manager
+ACTION inheritframe(name frame_name);
+
+//applies a frame to an item (links the item if frame is inherited)
 //auth: manager
 ACTION applyframe(name frame_name, uint64_t serial, bool overwrite);
 
@@ -15,6 +21,10 @@ ACTION applyframe(name frame_name, uint64_t serial, bool overwrite);
 //auth: manager
 ACTION quickbuild(name frame_name, name to, map<name, string> override_tags, map<name, int64_t> override_attributes);
 
+//mints one item per recipient and applies a frame with the same tag and attribute default overrides
+//auth: manager
+ACTION quickbuildn(name frame_name, vector<name> recipients, map<name, string> override_tags, map<name, int64_t> override_attributes);
+
 //cleans a frame from an item
 //auth: manager
 ACTION cleanframe(name frame_name, uint64_t serial);
@@ -35,11 +45,31 @@ TABLE frame {
     map<name, int64_t> default_attributes; //attribute_name => default value
     // map<name, time_point_sec> default_events; //event_name => default value
     // bool shared;
+    binary_extension<bool> inherit; //if true framed items read defaults from frame instead of copying them (empty if false)
 
     uint64_t primary_key() const { return frame_name.value; }
     uint64_t by_group() const { return group.value; }
-    EOSLIB_SERIALIZE(frame, (frame_name)(group)(default_tags)(default_attributes))
+    EOSLIB_SERIALIZE(frame, (frame_name)(group)(default_tags)(default_attributes)(inherit))
 };
 typedef multi_index<"frames"_n, frame,
     indexed_by<"bygroup"_n, const_mem_fun<frame, uint64_t, &frame::by_group>>
 > frames_table;
+
+//======================== frame functions ========================
+
+//resolve override tags and attributes into the rows a newly framed item needs written
+//NOTE: merges in frame defaults, or drops overrides equal to a default if frame is inherited
+void resolve_frame(const frame& frm, map<name, string>& tags, map<name, int64_t>& attributes);
+
+//get an inherited tag's content from an item's frame
+optional<string> inherited_tag(const item& itm, name tag_name);
+
+//get an inherited attribute's points from an item's frame
+optional<int64_t> inherited_attribute(const item& itm, name attribute_name);
+
+//write resolved tags and attributes to a newly minted item
+//pre: item has no tags or attributes, tag blobs already retained for item
+void decorate_item(uint64_t serial, const group& grp, const map<name, uint64_t>& tag_blobs, const map<name, int64_t>& resolved_attributes);
+
+//index ranked default attributes of an item linked to an inherited frame
+void rank_defaults(const frame& frm, const group& grp, const item& itm);
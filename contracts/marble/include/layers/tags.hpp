@@ -4,6 +4,7 @@
 //======================== tag actions ========================
 
 //assign a new tag to an item
+//NOTE: algorithm "sha256-content" verifies checksum as the sha256 hex of content
 //auth: manager
 ACTION newtag(uint64_t serial, name tag_name, string content, optional<string> checksum, optional<string> algorithm, bool shared);
 
@@ -19,6 +20,21 @@ ACTION locktag(uint64_t serial, name tag_name, bool shared);
 //auth: manager
 ACTION rmvtag(uint64_t serial, name group_name, name tag_name, string memo, bool shared);
 
+//tag operation
+struct tag_op {
+    name op; //create, update, lock, or remove
+    name tag_name;
+    string content; //ignored by lock and remove
+    optional<string> checksum;
+    optional<string> algorithm;
+
+    EOSLIB_SERIALIZE(tag_op, (op)(tag_name)(content)(checksum)(algorithm))
+};
+
+//apply a batch of tag operations to an item, or to its group's shared tags
+//auth: manager
+ACTION settags(uint64_t serial, vector<tag_op> ops, bool shared);
+
 //======================== tag tables ========================
 
 //tags table
@@ -26,14 +42,15 @@ ACTION rmvtag(uint64_t serial, name group_name, name tag_name, string memo, bool
 //ram payer: manager
 TABLE tag {
     name tag_name;
-    string content;
+    string content; //inline content of tags written before blob storage (blank if stored in a blob)
     string checksum;
     string algorithm;
     bool locked;
+    binary_extension<uint64_t> blob_id; //content stored in blobs table (0 or empty if content is inline)
 
     uint64_t primary_key() const { return tag_name.value; }
 
-    EOSLIB_SERIALIZE(tag, (tag_name)(content)(checksum)(algorithm)(locked))
+    EOSLIB_SERIALIZE(tag, (tag_name)(content)(checksum)(algorithm)(locked)(blob_id))
 };
 typedef multi_index<"tags"_n, tag> tags_table;
 
@@ -52,3 +69,37 @@ TABLE shared_tag {
     EOSLIB_SERIALIZE(shared_tag, (tag_name)(content)(checksum)(algorithm)(locked))
 };
 typedef multi_index<name("sharedtags"), shared_tag> shared_tags_table;
+
+//blobs table
+//scope: self
+//ram payer: contract
+TABLE blob {
+    uint64_t blob_id;
+    checksum256 content_hash; //sha256 of content
+    string content;
+    uint64_t refs; //number of item tags pointing at blob
+
+    uint64_t primary_key() const { return blob_id; }
+    checksum256 by_hash() const { return content_hash; }
+
+    EOSLIB_SERIALIZE(blob, (blob_id)(content_hash)(content)(refs))
+};
+typedef multi_index<name("blobs"), blob,
+    indexed_by<"byhash"_n, const_mem_fun<blob, checksum256, &blob::by_hash>>
+> blobs_table;
+
+//======================== tag functions ========================
+
+//verify a "sha256-content" checksum against a content hash, skipped for other algorithms
+void verify_checksum(const checksum256& content_hash, const string& checksum, const string& algorithm);
+
+//add references to the blob holding content, emplacing it if new, returns blob id
+//NOTE: blob ids start at 1, blob id 0 marks inline tag content
+uint64_t retain_blob(const checksum256& content_hash, const string& content, uint64_t refs);
+
+//retain a blob for each tag content, returns tag name => blob id
+map<name, uint64_t> retain_blobs(const map<name, string>& tags, uint64_t refs);
+
+//remove a reference from a blob, erasing it when unreferenced, no-op for inline content (blob id 0)
+void release_blob(uint64_t blob_id);
+
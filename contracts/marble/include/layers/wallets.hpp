@@ -9,14 +9,42 @@
 //auth: wallet owner
 ACTION withdraw(name wallet_owner, asset amount);
 
+//pay many recipients from a wallet, debiting the payer wallet once per currency
+//NOTE: recipient wallets are credited in place, recipients withdraw later
+//pre: balance >= total payout amount
+//auth: from
+ACTION payout(name from, vector<pair<name, asset>> payments);
+
+//register a token contract as a wallet and bond currency
+//auth: admin
+ACTION newcurrency(symbol currency_sym, name home_contract);
+
+//approve or suspend deposits of a currency
+//auth: admin
+ACTION setcurrency(symbol_code currency_code, bool approved);
+
+//set currency totals counted off-chain from existing wallets and bonds, registering the currency if not found
+//NOTE: registers currencies that already hold deposits, e.g. the core currency on upgraded deployments
+//auth: admin
+ACTION synccurrency(asset total_deposits, uint32_t total_wallets, uint32_t total_bonds, name home_contract);
+
+//unregister a currency
+//pre: no deposits, wallets, or bonds held in currency
+//auth: admin
+ACTION rmvcurrency(symbol_code currency_code);
+
 //withdraw items from a locker
 //auth: locker owner
 // ACTION withdrawitem(name locker_owner, name factory_name, uint64_t tracker_id);
 
 //======================== notification handlers ========================
 
-//catch a transfer() from eosio.token
-[[eosio::on_notify("eosio.token::transfer")]]
+//catch a transfer() from the home contract of an approved currency
+//NOTE: routed transfers of unregistered currencies are rejected
+//memo "deposit": credit sender wallet
+//memo "bond:<serial>": fund item bond, sender must be group manager
+//memo "bondrange:<first>:<last>": fund bonds of serials first to last equally, sender must be group manager
+[[eosio::on_notify("*::transfer")]]
 void catch_transfer(name from, name to, asset quantity, string memo);
 
 //catch a transferitem() from an approved factory contract
@@ -50,18 +78,19 @@ typedef multi_index<name("wallets"), wallet> wallets_table;
 //currencies table
 //scope: self
 //ram payer: contract
-// TABLE currency {
-//     asset total_deposits; //total deposited assets across all wallets
-//     uint32_t total_wallets; //total unique wallets
-//     name home_contract; //account where currency contract is deployed
-//     //string contract_standard;
-//     bool approved; //allows currency deposits
+TABLE currency {
+    asset total_deposits; //total deposited assets across all wallets
+    uint32_t total_wallets; //total unique wallets
+    name home_contract; //account where currency contract is deployed
+    //string contract_standard;
+    bool approved; //allows currency deposits
+    binary_extension<uint32_t> total_bonds; //total item bonds backed by currency
 
-//     uint64_t primary_key() const { return total_deposits.symbol.code().raw(); }
+    uint64_t primary_key() const { return total_deposits.symbol.code().raw(); }
 
-//     EOSLIB_SERIALIZE(currency, (total_deposits)(total_wallets)(home_contract)(approved))
-// };
-// typedef multi_index<name("currencies"), currency> currencies_table;
+    EOSLIB_SERIALIZE(currency, (total_deposits)(total_wallets)(home_contract)(approved)(total_bonds))
+};
+typedef multi_index<name("currencies"), currency> currencies_table;
 
 //factories table
 //scope: self
@@ -73,3 +102,22 @@ typedef multi_index<name("wallets"), wallet> wallets_table;
 //     bool approved; //allows item deposits
 // };
 // typedef multi_index<name("factories"), factory> factories_table;
+
+//======================== wallet functions ========================
+
+//add an amount to a wallet balance, creating the wallet if not found
+//ram payer: contract
+void credit_wallet(name wallet_owner, asset amount);
+
+//add amounts of many currencies to wallet balances
+//ram payer: contract
+void credit_wallets(name wallet_owner, const map<symbol_code, asset>& amounts);
+
+//subtract an amount from a wallet balance, erasing the wallet if emptied
+void debit_wallet(name wallet_owner, asset amount);
+
+//add to or subtract from the number of bonds backed by a currency
+void count_bonds(symbol_code currency_code, int64_t delta);
+
+//parse a decimal serial from a memo field
+uint64_t parse_serial(string_view digits);
@@ -11,6 +11,11 @@
 #include <eosio/action.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/asset.hpp>
+#include <eosio/crypto.hpp>
+#include <eosio/binary_extension.hpp>
+
+#include <algorithm>
+#include <string_view>
 
 using namespace std;
 using namespace eosio;
@@ -30,13 +35,31 @@ CONTRACT marble : public contract
 
     //constants
     const symbol CORE_SYM = symbol("TLOS", 4);
-    const name MINT = name("mint");
-    const name TRANSFER = name("transfer");
-    const name ACTIVATE = name("activate");
-    const name RECLAIM = name("reclaim");
-    const name CONSUME = name("consume");
-    const name DESTROY = name("destroy");
-    const name FREEZE = name("freeze");
+    static constexpr uint64_t SERIAL_BLOCK_SIZE = 10000; //serials reserved by a group at a time
+    static constexpr uint16_t MAX_VIEW_ITEMS = 100; //max items returned per getitems() page
+    static constexpr uint32_t MAX_VIEW_BYTES = 32768; //serialized item view bytes after which a getitems() page ends
+    static constexpr name MINT = "mint"_n;
+    static constexpr name TRANSFER = "transfer"_n;
+    static constexpr name ACTIVATE = "activate"_n;
+    static constexpr name RECLAIM = "reclaim"_n;
+    static constexpr name CONSUME = "consume"_n;
+    static constexpr name DESTROY = "destroy"_n;
+    static constexpr name FREEZE = "freeze"_n;
+
+    //core behavior flags (bit positions in group behavior_states and behavior_locks)
+    static constexpr uint8_t MINT_FLAG = 1 << 0;
+    static constexpr uint8_t TRANSFER_FLAG = 1 << 1;
+    static constexpr uint8_t ACTIVATE_FLAG = 1 << 2;
+    static constexpr uint8_t RECLAIM_FLAG = 1 << 3;
+    static constexpr uint8_t CONSUME_FLAG = 1 << 4;
+    static constexpr uint8_t DESTROY_FLAG = 1 << 5;
+    static constexpr uint8_t FREEZE_FLAG = 1 << 6;
+
+    //group layer options (bit positions in group options)
+    static constexpr uint8_t PACKED_ATTRS_OPT = 1 << 0; //item attributes stored in one packed row per item
+    static constexpr uint8_t RANKED_ATTRS_OPT = 1 << 1; //group has ranked attributes
+    static constexpr uint8_t EMIT_AGGREGATE_OPT = 1 << 2; //emit a logrange instead of a logevent from single item actions
+    static constexpr uint8_t EMIT_OFF_OPT = 1 << 3; //emit no item events
 
     //marble core
     #include <core/config.hpp>
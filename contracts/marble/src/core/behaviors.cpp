@@ -9,6 +9,9 @@ ACTION marble::addbehavior(name group_name, name behavior_name, bool initial_sta
     //authenticate
     require_auth(grp.manager);
 
+    //validate
+    check(core_behavior_flag(behavior_name) == 0, "behavior already exists");
+
     //search for behavior
     behaviors_table behaviors(get_self(), group_name.value);
     auto bhvr_itr = behaviors.find(behavior_name.value);
@@ -34,17 +37,34 @@ ACTION marble::togglebhvr(name group_name, name behavior_name)
     //authenticate
     require_auth(grp.manager);
 
-    //get behavior
-    behaviors_table behaviors(get_self(), group_name.value);
-    auto& bhvr = behaviors.get(behavior_name.value, "behavior not found");
-
-    //validate
-    check(!bhvr.locked, "behavior is locked");
-
-    //modify behavior
-    behaviors.modify(bhvr, same_payer, [&](auto& col) {
-        col.state = !bhvr.state;
-    });
+    //initialize
+    uint8_t flag = core_behavior_flag(behavior_name);
+
+    //if core behavior
+    if (flag != 0) {
+        //migrate group
+        migrate_group(groups, grp);
+
+        //validate
+        check(!(grp.behavior_locks.value() & flag), "behavior is locked");
+
+        //modify group
+        groups.modify(grp, same_payer, [&](auto& col) {
+            col.behavior_states.value() ^= flag;
+        });
+    } else {
+        //get behavior
+        behaviors_table behaviors(get_self(), group_name.value);
+        auto& bhvr = behaviors.get(behavior_name.value, "behavior not found");
+
+        //validate
+        check(!bhvr.locked, "behavior is locked");
+
+        //modify behavior
+        behaviors.modify(bhvr, same_payer, [&](auto& col) {
+            col.state = !bhvr.state;
+        });
+    }
 }
 
 ACTION marble::lockbhvr(name group_name, name behavior_name)
@@ -56,17 +76,34 @@ ACTION marble::lockbhvr(name group_name, name behavior_name)
     //authenticate
     require_auth(grp.manager);
 
-    //get behavior
-    behaviors_table behaviors(get_self(), group_name.value);
-    auto& bhvr = behaviors.get(behavior_name.value, "behavior not found");
-
-    //validate
-    check(!bhvr.locked, "behavior already locked");
-
-    //modify behavior
-    behaviors.modify(bhvr, same_payer, [&](auto& col) {
-        col.locked = true;
-    });
+    //initialize
+    uint8_t flag = core_behavior_flag(behavior_name);
+
+    //if core behavior
+    if (flag != 0) {
+        //migrate group
+        migrate_group(groups, grp);
+
+        //validate
+        check(!(grp.behavior_locks.value() & flag), "behavior already locked");
+
+        //modify group
+        groups.modify(grp, same_payer, [&](auto& col) {
+            col.behavior_locks.value() |= flag;
+        });
+    } else {
+        //get behavior
+        behaviors_table behaviors(get_self(), group_name.value);
+        auto& bhvr = behaviors.get(behavior_name.value, "behavior not found");
+
+        //validate
+        check(!bhvr.locked, "behavior already locked");
+
+        //modify behavior
+        behaviors.modify(bhvr, same_payer, [&](auto& col) {
+            col.locked = true;
+        });
+    }
 }
 
 ACTION marble::rmvbehavior(name group_name, name behavior_name)
@@ -78,6 +115,9 @@ ACTION marble::rmvbehavior(name group_name, name behavior_name)
     //authenticate
     require_auth(grp.manager);
 
+    //validate
+    check(core_behavior_flag(behavior_name) == 0, "core behaviors cannot be removed");
+
     //get behavior
     behaviors_table behaviors(get_self(), group_name.value);
     auto& bhvr = behaviors.get(behavior_name.value, "behavior not found");
@@ -87,3 +127,19 @@ ACTION marble::rmvbehavior(name group_name, name behavior_name)
     //erase behavior
     behaviors.erase(bhvr);
 }
+
+//======================== behavior functions ========================
+
+uint8_t marble::core_behavior_flag(name behavior_name)
+{
+    switch (behavior_name.value) {
+        case MINT.value: return MINT_FLAG;
+        case TRANSFER.value: return TRANSFER_FLAG;
+        case ACTIVATE.value: return ACTIVATE_FLAG;
+        case RECLAIM.value: return RECLAIM_FLAG;
+        case CONSUME.value: return CONSUME_FLAG;
+        case DESTROY.value: return DESTROY_FLAG;
+        case FREEZE.value: return FREEZE_FLAG;
+        default: return 0;
+    }
+}
@@ -22,6 +22,21 @@ ACTION marble::init(string contract_name, string contract_version, name initial_
 
     //set new config
     configs.set(new_conf, get_self());
+
+    //open serials table, set initial serial counter
+    serials_table serials(get_self(), get_self().value);
+    serials.set(serial_counter{uint64_t(0)}, get_self());
+
+    //open currencies table, register core currency
+    //ram payer: contract
+    currencies_table currencies(get_self(), get_self().value);
+    currencies.emplace(get_self(), [&](auto& col) {
+        col.total_deposits = asset(0, CORE_SYM);
+        col.total_wallets = 0;
+        col.home_contract = name("eosio.token");
+        col.approved = true;
+        col.total_bonds.emplace(0);
+    });
 }
 
 ACTION marble::setversion(string new_version)
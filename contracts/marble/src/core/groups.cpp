@@ -28,36 +28,12 @@ ACTION marble::newgroup(string title, string description, name group_name, name
         col.supply = 0;
         col.issued_supply = 0;
         col.supply_cap = supply_cap;
+        col.behavior_states.emplace(MINT_FLAG | TRANSFER_FLAG | DESTROY_FLAG);
+        col.behavior_locks.emplace(0);
+        col.next_serial.emplace(0);
+        col.serials_left.emplace(0);
+        col.options.emplace(0);
     });
-
-    //initialize
-    map<name, bool> initial_behaviors;
-    initial_behaviors["mint"_n] = true;
-    initial_behaviors["transfer"_n] = true;
-    initial_behaviors["activate"_n] = false;
-    initial_behaviors["reclaim"_n] = false;
-    initial_behaviors["consume"_n] = false;
-    initial_behaviors["destroy"_n] = true;
-
-    //for each initial behavior, emplace new behavior
-    for (pair p : initial_behaviors) {
-
-        //open behaviors table, search for behavior
-        behaviors_table behaviors(get_self(), group_name.value);
-        auto bhvr_itr = behaviors.find(p.first.value);
-
-        //validate
-        check(bhvr_itr == behaviors.end(), "behavior already exists");
-
-        //emplace new behavior
-        //ram payer: contract
-        behaviors.emplace(get_self(), [&](auto& col) {
-            col.behavior_name = p.first;
-            col.state = p.second;
-            col.locked = false;
-        });
-
-    }
 }
 
 ACTION marble::editgroup(name group_name, string new_title, string new_description)
@@ -69,6 +45,9 @@ ACTION marble::editgroup(name group_name, string new_title, string new_descripti
     //authenticate
     require_auth(grp.manager);
 
+    //migrate group
+    migrate_group(groups, grp);
+
     //modify group
     groups.modify(grp, same_payer, [&](auto& col) {
         col.title = new_title;
@@ -88,9 +67,82 @@ ACTION marble::setmanager(name group_name, name new_manager, string memo)
     //validate
     check(is_account(new_manager), "new manager account doesn't exist");
 
+    //migrate group
+    migrate_group(groups, grp);
+
     //modify group
     //TODO: change ram payer to new manager
     groups.modify(grp, same_payer, [&](auto& col) {
         col.manager = new_manager;
     });
 }
+
+ACTION marble::migrategroup(name group_name)
+{
+    //open config table, get config
+    config_table configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //authenticate
+    require_auth(conf.admin);
+
+    //get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group not found");
+
+    //validate
+    check(!grp.behavior_states.has_value(), "group already migrated");
+
+    //migrate group
+    migrate_group(groups, grp);
+}
+
+//======================== group functions ========================
+
+void marble::migrate_group(groups_table& groups, const group& grp)
+{
+    //if group already migrated
+    if (grp.behavior_states.has_value()) {
+        return;
+    }
+
+    //initialize
+    uint8_t states = 0;
+    uint8_t locks = 0;
+
+    //open behaviors table
+    behaviors_table behaviors(get_self(), grp.group_name.value);
+
+    //fold each core behavior row into group flags
+    for (name core_bhvr : {MINT, TRANSFER, ACTIVATE, RECLAIM, CONSUME, DESTROY, FREEZE}) {
+        //find behavior
+        auto bhvr_itr = behaviors.find(core_bhvr.value);
+
+        //if behavior found
+        if (bhvr_itr != behaviors.end()) {
+            //initialize
+            uint8_t flag = core_behavior_flag(core_bhvr);
+
+            //set flags
+            if (bhvr_itr->state) {
+                states |= flag;
+            }
+            if (bhvr_itr->locked) {
+                locks |= flag;
+            }
+
+            //erase behavior
+            behaviors.erase(bhvr_itr);
+        }
+    }
+
+    //fill group extension fields
+    //NOTE: serial block fields start empty, the next mint reserves a new block
+    groups.modify(grp, same_payer, [&](auto& col) {
+        col.behavior_states.emplace(states);
+        col.behavior_locks.emplace(locks);
+        col.next_serial.emplace(0);
+        col.serials_left.emplace(0);
+        col.options.emplace(0);
+    });
+}
@@ -9,36 +9,21 @@ ACTION marble::mintitem(name to, name group_name)
     //authenticate
     check(has_auth(grp.manager) || has_auth(get_self()), "only contract or group manager can mint items");
 
-    //open behaviors table, get behavior
-    behaviors_table behaviors(get_self(), group_name.value);
-    auto& bhvr = behaviors.get(name("mint").value, "behavior not found");
+    //migrate group
+    migrate_group(groups, grp);
 
     //validate
-    check(bhvr.state, "item is not mintable");
+    check(grp.behavior_states.value() & MINT_FLAG, "item is not mintable");
 
     //validate
     check(is_account(to), "to account doesn't exist");
     check(grp.supply < grp.supply_cap, "supply cap reached");
 
-    //open config table, get configs
-    config_table configs(get_self(), get_self().value);
-    auto conf = configs.get();
-
     //initialize
-    auto now = time_point_sec(current_time_point());
-    uint64_t new_serial = conf.last_serial + 1;
-    string logevent_memo = "serial: " + to_string(new_serial);
-
-    //increment last_serial, set new config
-    conf.last_serial += 1;
-    configs.set(conf, get_self());
+    uint64_t new_serial = reserve_serials(groups, grp, 1);
 
-    //open items table, find item
+    //open items table
     items_table items(get_self(), get_self().value);
-    auto itm = items.find(new_serial);
-
-    //validate
-    check(itm == items.end(), "serial already exists");
 
     //emplace new item
     //ram payer: self
@@ -46,48 +31,101 @@ ACTION marble::mintitem(name to, name group_name)
         col.serial = new_serial;
         col.group = group_name;
         col.owner = to;
+        col.frame.emplace(name(0));
     });
 
-    //update group
-    groups.modify(grp, same_payer, [&](auto& col) {
-        col.supply += 1;
-        col.issued_supply += 1;
-    });
+    //emit mint event
+    emit_event(grp, "mint"_n, new_serial, "serial: " + to_string(new_serial));
+}
+
+ACTION marble::mintitems(name to, name group_name, uint64_t count)
+{
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group name not found");
+
+    //authenticate
+    check(has_auth(grp.manager) || has_auth(get_self()), "only contract or group manager can mint items");
+
+    //migrate group
+    migrate_group(groups, grp);
+
+    //validate
+    check(grp.behavior_states.value() & MINT_FLAG, "item is not mintable");
+
+    //validate
+    check(is_account(to), "to account doesn't exist");
+    check(count > 0, "must mint at least one item");
+    check(count <= grp.supply_cap - grp.supply, "supply cap reached");
 
-    //inline logevent
-    action(permission_level{get_self(), name("active")}, get_self(), name("logevent"), make_tuple(
-        "mint"_n, //event_name
-        int64_t(new_serial), //event_value
-        now, //event_time
-        logevent_memo, //memo
-        false //shared
-    )).send();
+    //initialize
+    uint64_t first_serial = reserve_serials(groups, grp, count);
+    uint64_t last_serial = first_serial + count - 1;
+
+    //open items table
+    items_table items(get_self(), get_self().value);
+
+    //emplace new items
+    //NOTE: reserved serials are always unused, emplace will still reject a collision
+    for (uint64_t s = first_serial; s <= last_serial; s++) {
+        //emplace new item
+        //ram payer: self
+        items.emplace(get_self(), [&](auto& col) {
+            col.serial = s;
+            col.group = group_name;
+            col.owner = to;
+            col.frame.emplace(name(0));
+        });
+    }
+
+    //emit mint event
+    emit_range(grp, "mint"_n, first_serial, count);
 }
 
 ACTION marble::transferitem(name from, name to, vector<uint64_t> serials, string memo)
 {
+    //authenticate
+    require_auth(from);
+
     //validate
     check(is_account(to), "to account doesn't exist");
+    check(serials.size() > 0, "must transfer at least one item");
+
+    //validate no duplicate serials
+    vector<uint64_t> sorted_serials = serials;
+    sort(sorted_serials.begin(), sorted_serials.end());
+    check(adjacent_find(sorted_serials.begin(), sorted_serials.end()) == sorted_serials.end(), "duplicate serials in transfer");
+
+    //open items and groups tables
+    items_table items(get_self(), get_self().value);
+    groups_table groups(get_self(), get_self().value);
+
+    //initialize
+    //NOTE: caches transfer behavior per group, batches are usually a handful of groups
+    vector<name> checked_groups;
 
     //loop over serials
     for (uint64_t s : serials) {
-        //open items table, get item
-        items_table items(get_self(), get_self().value);
+        //get item
         auto& itm = items.get(s, "item not found");
 
-        //authenticate
-        require_auth(itm.owner);
+        //validate
+        check(itm.owner == from, "from account doesn't own item");
 
-        //open groups table, get group
-        groups_table groups(get_self(), get_self().value);
-        auto& grp = groups.get(itm.group.value, "group not found");
+        //if group not checked yet
+        if (find(checked_groups.begin(), checked_groups.end(), itm.group) == checked_groups.end()) {
+            //get group
+            auto& grp = groups.get(itm.group.value, "group not found");
 
-        //open behaviors table, get behavior
-        behaviors_table behaviors(get_self(), itm.group.value);
-        auto& bhvr = behaviors.get(name("transfer").value, "behavior not found");
+            //migrate group
+            migrate_group(groups, grp);
 
-        //validate
-        check(bhvr.state, "item is not transferable");
+            //validate
+            check(grp.behavior_states.value() & TRANSFER_FLAG, "item is not transferable");
+
+            //cache group
+            checked_groups.push_back(itm.group);
+        }
 
         //update item
         items.modify(itm, same_payer, [&](auto& col) {
@@ -109,12 +147,15 @@ ACTION marble::activateitem(uint64_t serial)
     //authenticate
     require_auth(itm.owner);
 
-    //open behaviors table, get behavior
-    behaviors_table behaviors(get_self(), itm.group.value);
-    auto& bhvr = behaviors.get(name("activate").value, "behavior not found");
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(itm.group.value, "group not found");
+
+    //migrate group
+    migrate_group(groups, grp);
 
     //validate
-    check(bhvr.state, "item is not activatable");
+    check(grp.behavior_states.value() & ACTIVATE_FLAG, "item is not activatable");
 }
 
 ACTION marble::reclaimitem(uint64_t serial)
@@ -130,12 +171,11 @@ ACTION marble::reclaimitem(uint64_t serial)
     //authenticate
     require_auth(grp.manager);
 
-    //open behaviors table, get behavior
-    behaviors_table behaviors(get_self(), itm.group.value);
-    auto& bhvr = behaviors.get(name("reclaim").value, "behavior not found");
+    //migrate group
+    migrate_group(groups, grp);
 
     //validate
-    check(bhvr.state, "item is not reclaimable");
+    check(grp.behavior_states.value() & RECLAIM_FLAG, "item is not reclaimable");
 
     //update item
     items.modify(itm, same_payer, [&](auto& col) {
@@ -156,35 +196,31 @@ ACTION marble::consumeitem(uint64_t serial)
     groups_table groups(get_self(), get_self().value);
     auto& grp = groups.get(itm.group.value, "group not found");
 
-    //open behaviors table, get behavior
-    behaviors_table behaviors(get_self(), itm.group.value);
-    auto& bhvr = behaviors.get(name("consume").value, "behavior not found");
+    //migrate group
+    migrate_group(groups, grp);
 
     //validate
-    check(bhvr.state, "item is not consumable");
+    check(grp.behavior_states.value() & CONSUME_FLAG, "item is not consumable");
     check(grp.supply > 0, "cannot reduce supply below zero");
 
-    //open bonds table, find bond
-    bonds_table bonds(get_self(), serial);
-    auto bond_itr = bonds.find(CORE_SYM.code().raw());
-
-    //if bond found
-    if (bond_itr != bonds.end()) {
-        //send inline marble::releaseall to self
-        //auth: self
-        action(permission_level{get_self(), name("active")}, get_self(), name("releaseall"), make_tuple(
-            serial, //serial
-            itm.owner //release_to
-        )).send();
-    }
+    //settle bonds to item owner
+    settle_bonds(serial, itm.owner);
 
     //update group
     groups.modify(grp, same_payer, [&](auto& col) {
         col.supply -= 1;
     });
 
+    //erase ranks
+    if (grp.options.value_or() & RANKED_ATTRS_OPT) {
+        clear_ranks(grp.group_name, serial);
+    }
+
     //erase item
     items.erase(itm);
+
+    //queue orphaned layer rows for purging
+    queue_purge(serial);
 }
 
 ACTION marble::destroyitem(uint64_t serial, string memo)
@@ -200,33 +236,525 @@ ACTION marble::destroyitem(uint64_t serial, string memo)
     //authenticate
     require_auth(grp.manager);
 
-    //open behaviors table, get behavior
-    behaviors_table behaviors(get_self(), itm.group.value);
-    auto& bhvr = behaviors.get(name("destroy").value, "behavior not found");
+    //migrate group
+    migrate_group(groups, grp);
 
     //validate
-    check(bhvr.state, "item is not destroyable");
+    check(grp.behavior_states.value() & DESTROY_FLAG, "item is not destroyable");
     check(grp.supply > 0, "cannot reduce supply below zero");
 
-    //open bonds table, find bond
-    bonds_table bonds(get_self(), serial);
-    auto bond_itr = bonds.find(CORE_SYM.code().raw());
-
-    //if bond found
-    if (bond_itr != bonds.end()) {
-        //send inline marble::releaseall to self
-        //auth: self
-        action(permission_level{get_self(), name("active")}, get_self(), name("releaseall"), make_tuple(
-            serial, //serial
-            itm.owner //release_to
-        )).send();
-    }
+    //settle bonds to item owner
+    settle_bonds(serial, itm.owner);
 
     //update group
     groups.modify(grp, same_payer, [&](auto& col) {
         col.supply -= 1;
     });
 
+    //erase ranks
+    if (grp.options.value_or() & RANKED_ATTRS_OPT) {
+        clear_ranks(grp.group_name, serial);
+    }
+
     //erase item
     items.erase(itm);
+
+    //queue orphaned layer rows for purging
+    queue_purge(serial);
+}
+
+ACTION marble::consumeitems(name owner, vector<uint64_t> serials)
+{
+    //authenticate
+    require_auth(owner);
+
+    //validate
+    check(serials.size() > 0, "must consume at least one item");
+
+    //validate no duplicate serials
+    vector<uint64_t> sorted_serials = serials;
+    sort(sorted_serials.begin(), sorted_serials.end());
+    check(adjacent_find(sorted_serials.begin(), sorted_serials.end()) == sorted_serials.end(), "duplicate serials in batch");
+
+    //open items and groups tables
+    items_table items(get_self(), get_self().value);
+    groups_table groups(get_self(), get_self().value);
+
+    //initialize
+    map<name, uint64_t> group_counts; //group_name => items consumed
+    vector<name> ranked_groups; //groups with ranked attributes
+    map<symbol_code, asset> bond_totals; //bond symbol => released bond total
+
+    //loop over serials
+    for (uint64_t s : serials) {
+        //get item
+        auto& itm = items.get(s, "item not found");
+
+        //validate
+        check(itm.owner == owner, "owner doesn't own item");
+
+        //if group not checked yet
+        if (group_counts.find(itm.group) == group_counts.end()) {
+            //get group
+            auto& grp = groups.get(itm.group.value, "group not found");
+
+            //migrate group
+            migrate_group(groups, grp);
+
+            //validate
+            check(grp.behavior_states.value() & CONSUME_FLAG, "item is not consumable");
+
+            //if group ranks attributes
+            if (grp.options.value_or() & RANKED_ATTRS_OPT) {
+                ranked_groups.push_back(grp.group_name);
+            }
+        }
+
+        //count item
+        group_counts[itm.group] += 1;
+
+        //add to bond totals, erase bonds
+        take_bonds(s, bond_totals);
+
+        //erase ranks
+        if (find(ranked_groups.begin(), ranked_groups.end(), itm.group) != ranked_groups.end()) {
+            clear_ranks(itm.group, s);
+        }
+
+        //erase item
+        items.erase(itm);
+
+        //queue orphaned layer rows for purging
+        queue_purge(s);
+    }
+
+    //update groups
+    for (auto& gc : group_counts) {
+        //get group
+        auto& grp = groups.get(gc.first.value, "group not found");
+
+        //validate
+        check(grp.supply >= gc.second, "cannot reduce supply below zero");
+
+        //update group
+        groups.modify(grp, same_payer, [&](auto& col) {
+            col.supply -= gc.second;
+        });
+    }
+
+    //credit owner wallets once per currency
+    credit_wallets(owner, bond_totals);
+}
+
+ACTION marble::destroyitems(vector<uint64_t> serials, string memo)
+{
+    //validate
+    check(serials.size() > 0, "must destroy at least one item");
+
+    //validate no duplicate serials
+    vector<uint64_t> sorted_serials = serials;
+    sort(sorted_serials.begin(), sorted_serials.end());
+    check(adjacent_find(sorted_serials.begin(), sorted_serials.end()) == sorted_serials.end(), "duplicate serials in batch");
+
+    //open items and groups tables
+    items_table items(get_self(), get_self().value);
+    groups_table groups(get_self(), get_self().value);
+
+    //initialize
+    map<name, uint64_t> group_counts; //group_name => items destroyed
+    vector<name> ranked_groups; //groups with ranked attributes
+    map<name, map<symbol_code, asset>> payouts; //owner => bond symbol => released bond total
+
+    //loop over serials
+    for (uint64_t s : serials) {
+        //get item
+        auto& itm = items.get(s, "item not found");
+
+        //if group not checked yet
+        if (group_counts.find(itm.group) == group_counts.end()) {
+            //get group
+            auto& grp = groups.get(itm.group.value, "group not found");
+
+            //authenticate
+            require_auth(grp.manager);
+
+            //migrate group
+            migrate_group(groups, grp);
+
+            //validate
+            check(grp.behavior_states.value() & DESTROY_FLAG, "item is not destroyable");
+
+            //if group ranks attributes
+            if (grp.options.value_or() & RANKED_ATTRS_OPT) {
+                ranked_groups.push_back(grp.group_name);
+            }
+        }
+
+        //count item
+        group_counts[itm.group] += 1;
+
+        //add to owner payouts, erase bonds
+        take_bonds(s, payouts[itm.owner]);
+
+        //erase ranks
+        if (find(ranked_groups.begin(), ranked_groups.end(), itm.group) != ranked_groups.end()) {
+            clear_ranks(itm.group, s);
+        }
+
+        //erase item
+        items.erase(itm);
+
+        //queue orphaned layer rows for purging
+        queue_purge(s);
+    }
+
+    //update groups
+    for (auto& gc : group_counts) {
+        //get group
+        auto& grp = groups.get(gc.first.value, "group not found");
+
+        //validate
+        check(grp.supply >= gc.second, "cannot reduce supply below zero");
+
+        //update group
+        groups.modify(grp, same_payer, [&](auto& col) {
+            col.supply -= gc.second;
+        });
+    }
+
+    //credit owner wallets once per currency
+    for (auto& p : payouts) {
+        credit_wallets(p.first, p.second);
+    }
+}
+
+ACTION marble::purgeitem(uint64_t serial, uint16_t max_rows)
+{
+    //open purges table, find purge
+    //NOTE: items erased before purge queueing have no purge
+    purges_table purges(get_self(), get_self().value);
+    auto prg_itr = purges.find(serial);
+
+    //open items table, find item
+    items_table items(get_self(), get_self().value);
+    auto itm_itr = items.find(serial);
+
+    //validate
+    check(itm_itr == items.end(), "cannot purge an existing item");
+    check(max_rows > 0, "max rows must be greater than zero");
+
+    //initialize
+    uint16_t rows_left = max_rows;
+
+    //open tags table, erase tags
+    tags_table tags(get_self(), serial);
+    auto tg_itr = tags.begin();
+    while (tg_itr != tags.end() && rows_left > 0) {
+        release_blob(tg_itr->blob_id.value_or());
+        tg_itr = tags.erase(tg_itr);
+        rows_left--;
+    }
+
+    //open attributes table, erase attributes
+    attributes_table attributes(get_self(), serial);
+    auto attr_itr = attributes.begin();
+    while (attr_itr != attributes.end() && rows_left > 0) {
+        attr_itr = attributes.erase(attr_itr);
+        rows_left--;
+    }
+
+    //open attribute packs table, erase pack
+    attribute_packs_table packs(get_self(), get_self().value);
+    auto pack_itr = packs.find(serial);
+    if (pack_itr != packs.end() && rows_left > 0) {
+        packs.erase(pack_itr);
+        pack_itr = packs.end();
+        rows_left--;
+    }
+
+    //open events table, erase events
+    events_table events(get_self(), serial);
+    auto evnt_itr = events.begin();
+    while (evnt_itr != events.end() && rows_left > 0) {
+        evnt_itr = events.erase(evnt_itr);
+        rows_left--;
+    }
+
+    //validate
+    check(rows_left < max_rows || prg_itr != purges.end(), "no orphaned rows to purge");
+
+    //if all rows purged and item queued
+    if (tg_itr == tags.end() && attr_itr == attributes.end() && pack_itr == packs.end() && evnt_itr == events.end() && prg_itr != purges.end()) {
+        //erase purge
+        purges.erase(prg_itr);
+    }
+}
+
+marble::item_view_page marble::getitems(vector<uint64_t> serials, uint16_t cursor)
+{
+    //validate
+    check(serials.size() > 0, "must request at least one item");
+    check(serials.size() <= UINT16_MAX, "too many serials requested");
+    check(cursor < serials.size(), "cursor out of range");
+
+    //initialize
+    item_view_page page;
+    page.next_cursor = 0;
+    uint32_t view_bytes = 0;
+    map<name, vector<tag_view>> shared_tags_cache; //group => shared tags
+    map<name, vector<attribute_view>> shared_attrs_cache; //group => shared attributes
+    map<name, vector<event_view>> shared_events_cache; //group => shared events
+
+    //open items, frames, blobs, and attribute packs tables
+    items_table items(get_self(), get_self().value);
+    frames_table frames(get_self(), get_self().value);
+    blobs_table blobs(get_self(), get_self().value);
+    attribute_packs_table packs(get_self(), get_self().value);
+
+    for (uint16_t i = cursor; i < serials.size(); i++) {
+        //if page full
+        if (page.items.size() == MAX_VIEW_ITEMS || view_bytes >= MAX_VIEW_BYTES) {
+            page.next_cursor = i;
+            break;
+        }
+
+        //find item
+        auto itm_itr = items.find(serials[i]);
+
+        //skip missing items
+        if (itm_itr == items.end()) {
+            continue;
+        }
+
+        //load group shared layers once per page
+        if (shared_tags_cache.find(itm_itr->group) == shared_tags_cache.end()) {
+            auto& grp_tags = shared_tags_cache[itm_itr->group];
+            shared_tags_table shared_tags(get_self(), itm_itr->group.value);
+            for (auto& st : shared_tags) {
+                grp_tags.push_back({st.tag_name, st.content, st.checksum, st.algorithm, st.locked, true});
+            }
+
+            auto& grp_attrs = shared_attrs_cache[itm_itr->group];
+            shared_attributes_table shared_attributes(get_self(), itm_itr->group.value);
+            for (auto& sa : shared_attributes) {
+                grp_attrs.push_back({sa.attribute_name, sa.points, sa.locked, true});
+            }
+
+            auto& grp_events = shared_events_cache[itm_itr->group];
+            shared_events_table shared_events(get_self(), itm_itr->group.value);
+            for (auto& se : shared_events) {
+                grp_events.push_back({se.event_name, se.event_time, se.locked, true});
+            }
+        }
+
+        //initialize resolved layers with shared values
+        map<name, tag_view> resolved_tags;
+        for (auto& tv : shared_tags_cache[itm_itr->group]) {
+            resolved_tags[tv.tag_name] = tv;
+        }
+        map<name, attribute_view> resolved_attrs;
+        for (auto& av : shared_attrs_cache[itm_itr->group]) {
+            resolved_attrs[av.attribute_name] = av;
+        }
+        map<name, event_view> resolved_events;
+        for (auto& ev : shared_events_cache[itm_itr->group]) {
+            resolved_events[ev.event_name] = ev;
+        }
+
+        //override with inherited frame defaults
+        if (itm_itr->frame.value_or() != name(0)) {
+            auto& frm = frames.get(itm_itr->frame.value_or().value, "frame not found");
+            for (auto& t : frm.default_tags) {
+                resolved_tags[t.first] = {t.first, t.second, "", "", false, false};
+            }
+            for (auto& a : frm.default_attributes) {
+                resolved_attrs[a.first] = {a.first, a.second, false, false};
+            }
+        }
+
+        //override with item tags
+        tags_table tags(get_self(), itm_itr->serial);
+        for (auto& t : tags) {
+            //if content is inline
+            if (t.blob_id.value_or() == 0) {
+                resolved_tags[t.tag_name] = {t.tag_name, t.content, t.checksum, t.algorithm, t.locked, false};
+            } else {
+                auto& b = blobs.get(t.blob_id.value(), "blob not found");
+                resolved_tags[t.tag_name] = {t.tag_name, b.content, t.checksum, t.algorithm, t.locked, false};
+            }
+        }
+
+        //override with item attributes
+        attributes_table attributes(get_self(), itm_itr->serial);
+        for (auto& a : attributes) {
+            resolved_attrs[a.attribute_name] = {a.attribute_name, a.points, a.locked, false};
+        }
+
+        //override with packed item attributes
+        auto pack_itr = packs.find(itm_itr->serial);
+        if (pack_itr != packs.end()) {
+            for (size_t j = 0; j < pack_itr->attributes.size(); j++) {
+                auto& pa = pack_itr->attributes[j];
+                resolved_attrs[pa.attribute_name] = {pa.attribute_name, pa.points, pack_itr->is_locked(j), false};
+            }
+        }
+
+        //override with item events
+        events_table events(get_self(), itm_itr->serial);
+        for (auto& e : events) {
+            resolved_events[e.event_name] = {e.event_name, e.event_time, e.locked, false};
+        }
+
+        //build item view
+        item_view view;
+        view.serial = itm_itr->serial;
+        view.group = itm_itr->group;
+        view.owner = itm_itr->owner;
+        view.frame = itm_itr->frame.value_or();
+
+        for (auto& rt : resolved_tags) {
+            view.tags.push_back(rt.second);
+        }
+        for (auto& ra : resolved_attrs) {
+            view.attributes.push_back(ra.second);
+        }
+        for (auto& re : resolved_events) {
+            view.events.push_back(re.second);
+        }
+
+        //add bonds
+        bonds_table bonds(get_self(), itm_itr->serial);
+        for (auto& b : bonds) {
+            view.bonds.push_back({b.backed_amount, b.release_event, b.locked, b.start_time.value_or(), b.step_period.value_or(), b.steps.value_or(), b.claimed_steps.value_or(), b.per_step.value_or(asset(0, b.backed_amount.symbol))});
+        }
+
+        //count serialized view size
+        view_bytes += pack_size(view);
+
+        page.items.push_back(view);
+    }
+
+    return page;
+}
+
+//======================== item functions ========================
+
+uint64_t marble::reserve_serials(groups_table& groups, const group& grp, uint64_t count)
+{
+    //initialize
+    uint64_t first_serial = grp.next_serial.value();
+    uint64_t serials_left = grp.serials_left.value();
+
+    //if reserved block can't fit count
+    if (serials_left < count) {
+        //open serials table
+        serials_table serials(get_self(), get_self().value);
+
+        //initialize
+        serial_counter ctr;
+
+        //if serial counter exists
+        if (serials.exists()) {
+            //get serial counter
+            ctr = serials.get();
+        } else {
+            //open config table, seed serial counter from legacy counter
+            config_table configs(get_self(), get_self().value);
+            ctr.last_serial = configs.get().last_serial;
+        }
+
+        //reserve new block, abandon remainder of old block
+        uint64_t block_size = max(SERIAL_BLOCK_SIZE, count);
+        first_serial = ctr.last_serial + 1;
+        serials_left = block_size;
+
+        //update serial counter
+        ctr.last_serial += block_size;
+        serials.set(ctr, get_self());
+    }
+
+    //update group
+    groups.modify(grp, same_payer, [&](auto& col) {
+        col.supply += count;
+        col.issued_supply += count;
+        col.next_serial.emplace(first_serial + count);
+        col.serials_left.emplace(serials_left - count);
+    });
+
+    return first_serial;
+}
+
+void marble::queue_purge(uint64_t serial)
+{
+    //open layer tables
+    tags_table tags(get_self(), serial);
+    attributes_table attributes(get_self(), serial);
+    attribute_packs_table packs(get_self(), get_self().value);
+    events_table events(get_self(), serial);
+
+    //if item left any layer rows
+    if (tags.begin() != tags.end() || attributes.begin() != attributes.end() || packs.find(serial) != packs.end() || events.begin() != events.end()) {
+        //open purges table
+        purges_table purges(get_self(), get_self().value);
+
+        //emplace new purge
+        //ram payer: contract
+        purges.emplace(get_self(), [&](auto& col) {
+            col.serial = serial;
+        });
+    }
+}
+
+//======================== item queries ========================
+
+marble::inventory_page marble::getinventory(name owner, name group_name, name cursor_group, uint64_t cursor, uint16_t limit)
+{
+    //validate
+    check(limit > 0 && limit <= 1000, "limit must be between 1 and 1000");
+    check(group_name == name(0) || cursor == 0 || cursor_group == group_name, "cursor group not in inventory");
+
+    //initialize
+    uint128_t upper_key = (group_name == name(0)) ? (uint128_t(owner.value) << 64) | UINT64_MAX : (uint128_t(owner.value) << 64) | group_name.value;
+    uint128_t resume_key = (uint128_t(owner.value) << 64) | ((cursor != 0) ? cursor_group.value : group_name.value);
+    inventory_page page;
+    page.next_group = name(0);
+    page.next_cursor = 0;
+
+    //open items table, get owner group index
+    items_table items(get_self(), get_self().value);
+    auto by_owner_group = items.get_index<"byownergrp"_n>();
+    auto itr = by_owner_group.lower_bound(resume_key);
+
+    //if resuming from cursor
+    if (cursor != 0) {
+        //find cursor item
+        auto cur_itr = items.find(cursor);
+
+        //if cursor item still in place
+        if (cur_itr != items.end() && cur_itr->by_owner_group() == resume_key) {
+            //seek past cursor item
+            itr = by_owner_group.iterator_to(*cur_itr);
+            itr++;
+        } else {
+            //skip items at or before cursor in cursor group
+            while (itr != by_owner_group.end() && itr->by_owner_group() == resume_key && itr->serial <= cursor) {
+                itr++;
+            }
+        }
+    }
+
+    //collect items in range
+    while (itr != by_owner_group.end() && itr->by_owner_group() <= upper_key) {
+        //if page full
+        if (page.items.size() == limit) {
+            page.next_group = page.items.back().group;
+            page.next_cursor = page.items.back().serial;
+            break;
+        }
+
+        page.items.push_back({itr->serial, itr->group});
+        itr++;
+    }
+
+    return page;
 }
@@ -30,20 +30,15 @@ ACTION marble::newattribute(uint64_t serial, name attribute_name, int64_t initia
             col.locked = false;
         });
     } else {
-        //open attributes table, find attribute
-        attributes_table attributes(get_self(), serial);
-        auto attr_itr = attributes.find(attribute_name.value);
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
 
         //validate
-        check(attr_itr == attributes.end(), "attribute name already exists for item");
+        check(!attr || !attr->stored, "attribute name already exists for item");
+        check(!attr, "attribute name already inherited from frame");
 
         //create new attribute
-        //ram payer: contract
-        attributes.emplace(get_self(), [&](auto& col) {
-            col.attribute_name = attribute_name;
-            col.points = initial_points;
-            col.locked = false;
-        });
+        put_item_attribute(serial, grp, attribute_name, initial_points, false);
     }
 }
 
@@ -74,17 +69,15 @@ ACTION marble::setpoints(uint64_t serial, name attribute_name, int64_t new_point
             col.points = new_points;
         });
     } else {
-        //open attributes table, get attribute
-        attributes_table attributes(get_self(), serial);
-        auto& attr = attributes.get(attribute_name.value, "attribute not found");
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
 
         //validate
-        check(!attr.locked, "attribute is locked");
+        check(attr.has_value(), "attribute not found");
+        check(!attr->locked, "attribute is locked");
 
-        //update attribute
-        attributes.modify(attr, same_payer, [&](auto& col) {
-            col.points = new_points;
-        });
+        //update attribute, overrides inherited attribute
+        put_item_attribute(serial, grp, attribute_name, new_points, false);
     }
 }
 
@@ -118,17 +111,15 @@ ACTION marble::increasepts(uint64_t serial, name attribute_name, uint64_t points
             col.points += points_to_add;
         });
     } else {
-        //open attributes table, get attribute
-        attributes_table attributes(get_self(), serial);
-        auto& attr = attributes.get(attribute_name.value, "attribute not found");
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
 
         //validate
-        check(!attr.locked, "attribute is locked");
+        check(attr.has_value(), "attribute not found");
+        check(!attr->locked, "attribute is locked");
 
-        //update attribute
-        attributes.modify(attr, same_payer, [&](auto& col) {
-            col.points += points_to_add;
-        });
+        //update attribute, overrides inherited attribute
+        put_item_attribute(serial, grp, attribute_name, attr->points + points_to_add, false);
     }
 }
 
@@ -162,17 +153,15 @@ ACTION marble::decreasepts(uint64_t serial, name attribute_name, uint64_t points
             col.points -= points_to_subtract;
         });
     } else {
-        //open attributes table, get attribute
-        attributes_table attributes(get_self(), serial);
-        auto& attr = attributes.get(attribute_name.value, "attribute not found");
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
 
         //validate
-        check(!attr.locked, "attribute is locked");
+        check(attr.has_value(), "attribute not found");
+        check(!attr->locked, "attribute is locked");
 
-        //update attribute
-        attributes.modify(attr, same_payer, [&](auto& col) {
-            col.points -= points_to_subtract;
-        });
+        //update attribute, overrides inherited attribute
+        put_item_attribute(serial, grp, attribute_name, attr->points - points_to_subtract, false);
     }
 }
 
@@ -203,17 +192,15 @@ ACTION marble::lockattr(uint64_t serial, name attribute_name, bool shared)
             col.locked = true;
         });
     } else {
-        //open attributes table, get attribute
-        attributes_table attributes(get_self(), serial);
-        auto& attr = attributes.get(attribute_name.value, "attribute not found");
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
 
         //validate
-        check(!attr.locked, "attribute is already locked");
+        check(attr.has_value(), "attribute not found");
+        check(!attr->locked, "attribute is already locked");
 
-        //update attribute
-        attributes.modify(attr, same_payer, [&](auto& col) {
-            col.locked = true;
-        });
+        //lock attribute, copies inherited attribute
+        put_item_attribute(serial, grp, attribute_name, attr->points, true);
     }
 }
 
@@ -235,11 +222,525 @@ ACTION marble::rmvattribute(uint64_t serial, name group_name, name attribute_nam
         //remove shared attribute
         shared_attributes.erase(sh_attr);
     } else {
-        //open attributes table, get attribute
+        //remove attribute
+        check(erase_item_attribute(serial, grp, attribute_name), "attribute not found");
+    }
+}
+
+ACTION marble::applydeltas(vector<attribute_delta> deltas)
+{
+    //validate
+    check(deltas.size() > 0, "must apply at least one delta");
+
+    //initialize
+    map<uint64_t, map<name, int64_t>> item_deltas; //serial => (attribute_name => summed delta)
+    map<uint64_t, map<name, int64_t>> shared_deltas; //serial => (attribute_name => summed delta)
+
+    //sum repeated deltas
+    for (auto& d : deltas) {
+        auto& sum = (d.shared) ? shared_deltas[d.serial][d.attribute_name] : item_deltas[d.serial][d.attribute_name];
+        sum = add_points(sum, d.delta);
+    }
+
+    //open items, groups, and attribute packs tables
+    items_table items(get_self(), get_self().value);
+    groups_table groups(get_self(), get_self().value);
+    attribute_packs_table packs(get_self(), get_self().value);
+
+    //initialize
+    vector<name> authed_groups;
+    map<name, map<name, int64_t>> group_deltas; //group_name => (attribute_name => summed delta)
+
+    //authenticate group manager once per group
+    auto get_group = [&](name group_name) -> const group& {
+        auto& grp = groups.get(group_name.value, "group not found");
+        if (find(authed_groups.begin(), authed_groups.end(), group_name) == authed_groups.end()) {
+            require_auth(grp.manager);
+            authed_groups.push_back(group_name);
+        }
+        return grp;
+    };
+
+    //merge shared deltas by group
+    for (auto& sd : shared_deltas) {
+        auto& itm = items.get(sd.first, "item not found");
+        get_group(itm.group);
+        for (auto& a : sd.second) {
+            auto& sum = group_deltas[itm.group][a.first];
+            sum = add_points(sum, a.second);
+        }
+    }
+
+    //apply shared deltas
+    for (auto& gd : group_deltas) {
+        //open shared attributes table
+        shared_attributes_table shared_attributes(get_self(), gd.first.value);
+
+        for (auto& a : gd.second) {
+            //get shared attribute
+            auto& sh_attr = shared_attributes.get(a.first.value, "shared attribute not found");
+
+            //validate
+            check(!sh_attr.locked, "shared attribute is locked");
+
+            //update shared attribute
+            shared_attributes.modify(sh_attr, same_payer, [&](auto& col) {
+                col.points = add_points(col.points, a.second);
+            });
+        }
+    }
+
+    //apply item deltas
+    for (auto& id : item_deltas) {
+        //get item and group
+        auto& itm = items.get(id.first, "item not found");
+        auto& grp = get_group(itm.group);
+
+        //if packed attributes
+        if (grp.options.value_or() & PACKED_ATTRS_OPT) {
+            //find pack
+            auto pack_itr = packs.find(itm.serial);
+            attribute_pack new_pack;
+            if (pack_itr != packs.end()) {
+                new_pack = *pack_itr;
+            } else {
+                new_pack.serial = itm.serial;
+            }
+
+            //apply deltas to pack copy
+            for (auto& a : id.second) {
+                size_t index = new_pack.index_of(a.first);
+
+                //if attribute not in pack
+                if (index == new_pack.attributes.size()) {
+                    //get inherited attribute
+                    auto inh_points = inherited_attribute(itm, a.first);
+
+                    //validate
+                    check(inh_points.has_value(), "attribute not found");
+
+                    index = new_pack.insert(a.first, *inh_points);
+                }
+
+                //validate
+                check(!new_pack.is_locked(index), "attribute is locked");
+
+                new_pack.attributes[index].points = add_points(new_pack.attributes[index].points, a.second);
+            }
+
+            //write pack once
+            if (pack_itr != packs.end()) {
+                packs.modify(pack_itr, same_payer, [&](auto& col) {
+                    col = new_pack;
+                });
+            } else {
+                //ram payer: contract
+                packs.emplace(get_self(), [&](auto& col) {
+                    col = new_pack;
+                });
+            }
+
+            //update ranks
+            for (auto& a : id.second) {
+                sync_rank(grp, itm.serial, a.first, new_pack.attributes[new_pack.index_of(a.first)].points);
+            }
+        } else {
+            //apply deltas to attribute rows
+            for (auto& a : id.second) {
+                //get attribute
+                auto attr = get_item_attribute(itm, grp, a.first);
+
+                //validate
+                check(attr.has_value(), "attribute not found");
+                check(!attr->locked, "attribute is locked");
+
+                //update attribute, overrides inherited attribute
+                put_item_attribute(itm.serial, grp, a.first, add_points(attr->points, a.second), false);
+            }
+        }
+    }
+}
+
+ACTION marble::setattrmode(name group_name, bool packed)
+{
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //migrate group
+    migrate_group(groups, grp);
+
+    //validate
+    check(grp.issued_supply == 0, "attribute mode can only be set before first mint");
+    check(bool(grp.options.value_or() & PACKED_ATTRS_OPT) != packed, "attribute mode already set");
+
+    //update group options
+    groups.modify(grp, same_payer, [&](auto& col) {
+        col.options.value() ^= PACKED_ATTRS_OPT;
+    });
+}
+
+ACTION marble::rankattr(name group_name, name attribute_name)
+{
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //migrate group
+    migrate_group(groups, grp);
+
+    //open ranked attributes table, find ranked attribute
+    ranked_attributes_table ranked_attributes(get_self(), group_name.value);
+    auto rnk_attr_itr = ranked_attributes.find(attribute_name.value);
+
+    //validate
+    check(attribute_name != name(0), "attribute name cannot be empty");
+    check(rnk_attr_itr == ranked_attributes.end(), "attribute is already ranked");
+
+    //emplace ranked attribute
+    //ram payer: contract
+    ranked_attributes.emplace(get_self(), [&](auto& col) {
+        col.attribute_name = attribute_name;
+    });
+
+    //enable ranking on group
+    if (!(grp.options.value_or() & RANKED_ATTRS_OPT)) {
+        groups.modify(grp, same_payer, [&](auto& col) {
+            col.options.value() |= RANKED_ATTRS_OPT;
+        });
+    }
+}
+
+ACTION marble::syncranks(name group_name, name attribute_name, vector<uint64_t> serials)
+{
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group not found");
+
+    //open ranked attributes table, get ranked attribute
+    ranked_attributes_table ranked_attributes(get_self(), group_name.value);
+    ranked_attributes.get(attribute_name.value, "attribute is not ranked");
+
+    //open items table
+    items_table items(get_self(), get_self().value);
+
+    for (uint64_t s : serials) {
+        //get item
+        auto& itm = items.get(s, "item not found");
+
+        //validate
+        check(itm.group == group_name, "item is not in group");
+
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, attribute_name);
+
+        //rank stored or inherited points
+        sync_rank(grp, s, attribute_name, attr ? optional<int64_t>(attr->points) : optional<int64_t>());
+    }
+}
+
+//======================== attribute functions ========================
+
+optional<marble::attribute_slot> marble::get_item_attribute(const item& itm, const group& grp, name attribute_name)
+{
+    //if packed attributes
+    if (grp.options.value_or() & PACKED_ATTRS_OPT) {
+        //open attribute packs table, find pack
+        attribute_packs_table packs(get_self(), get_self().value);
+        auto pack_itr = packs.find(itm.serial);
+
+        if (pack_itr != packs.end()) {
+            //binary search for attribute
+            size_t index = pack_itr->index_of(attribute_name);
+
+            if (index < pack_itr->attributes.size()) {
+                return attribute_slot{pack_itr->attributes[index].points, pack_itr->is_locked(index), true};
+            }
+        }
+    } else {
+        //open attributes table, find attribute
+        attributes_table attributes(get_self(), itm.serial);
+        auto attr_itr = attributes.find(attribute_name.value);
+
+        if (attr_itr != attributes.end()) {
+            return attribute_slot{attr_itr->points, attr_itr->locked, true};
+        }
+    }
+
+    //get inherited attribute
+    auto inh_points = inherited_attribute(itm, attribute_name);
+
+    if (!inh_points) {
+        return {};
+    }
+
+    return attribute_slot{*inh_points, false, false};
+}
+
+void marble::put_item_attribute(uint64_t serial, const group& grp, name attribute_name, int64_t points, bool locked)
+{
+    //if packed attributes
+    if (grp.options.value_or() & PACKED_ATTRS_OPT) {
+        //open attribute packs table, find pack
+        attribute_packs_table packs(get_self(), get_self().value);
+        auto pack_itr = packs.find(serial);
+
+        //if pack not found
+        if (pack_itr == packs.end()) {
+            //emplace new pack
+            //ram payer: contract
+            packs.emplace(get_self(), [&](auto& col) {
+                col.serial = serial;
+                col.attributes = { {attribute_name, points} };
+                col.lock_bits = { uint8_t(locked ? 1 : 0) };
+            });
+        } else {
+            //update pack
+            packs.modify(pack_itr, same_payer, [&](auto& col) {
+                size_t index = col.index_of(attribute_name);
+
+                //if attribute not in pack
+                if (index == col.attributes.size()) {
+                    index = col.insert(attribute_name, points);
+                } else {
+                    col.attributes[index].points = points;
+                }
+
+                col.set_locked(index, locked);
+            });
+        }
+    } else {
+        //open attributes table, find attribute
         attributes_table attributes(get_self(), serial);
-        auto& attr = attributes.get(attribute_name.value, "attribute not found");
+        auto attr_itr = attributes.find(attribute_name.value);
 
-        //remove attribute
-        attributes.erase(attr);
+        //if attribute not found
+        if (attr_itr == attributes.end()) {
+            //emplace new attribute
+            //ram payer: contract
+            attributes.emplace(get_self(), [&](auto& col) {
+                col.attribute_name = attribute_name;
+                col.points = points;
+                col.locked = locked;
+            });
+        } else {
+            //update attribute
+            attributes.modify(attr_itr, same_payer, [&](auto& col) {
+                col.points = points;
+                col.locked = locked;
+            });
+        }
+    }
+
+    //update rank
+    sync_rank(grp, serial, attribute_name, points);
+}
+
+bool marble::erase_item_attribute(uint64_t serial, const group& grp, name attribute_name)
+{
+    //if packed attributes
+    if (grp.options.value_or() & PACKED_ATTRS_OPT) {
+        //open attribute packs table, find pack
+        attribute_packs_table packs(get_self(), get_self().value);
+        auto pack_itr = packs.find(serial);
+
+        if (pack_itr == packs.end()) {
+            return false;
+        }
+
+        //binary search for attribute
+        size_t index = pack_itr->index_of(attribute_name);
+
+        if (index == pack_itr->attributes.size()) {
+            return false;
+        }
+
+        //if last attribute in pack
+        if (pack_itr->attributes.size() == 1) {
+            //erase pack
+            packs.erase(pack_itr);
+        } else {
+            //remove attribute from pack
+            packs.modify(pack_itr, same_payer, [&](auto& col) {
+                col.erase(index);
+            });
+        }
+    } else {
+        //open attributes table, find attribute
+        attributes_table attributes(get_self(), serial);
+        auto attr_itr = attributes.find(attribute_name.value);
+
+        if (attr_itr == attributes.end()) {
+            return false;
+        }
+
+        //erase attribute
+        attributes.erase(attr_itr);
+    }
+
+    //erase rank, falls back to inherited points
+    sync_rank(grp, serial, attribute_name, {});
+
+    return true;
+}
+
+void marble::sync_rank(const group& grp, uint64_t serial, name attribute_name, optional<int64_t> points)
+{
+    //skip groups without ranked attributes
+    if (!(grp.options.value_or() & RANKED_ATTRS_OPT)) {
+        return;
+    }
+
+    //open ranked attributes table, find ranked attribute
+    ranked_attributes_table ranked_attributes(get_self(), grp.group_name.value);
+    if (ranked_attributes.find(attribute_name.value) == ranked_attributes.end()) {
+        return;
     }
+
+    //if no stored points, rank inherited frame default
+    if (!points) {
+        //open items table, find item
+        items_table items(get_self(), get_self().value);
+        auto itm_itr = items.find(serial);
+
+        if (itm_itr != items.end()) {
+            points = inherited_attribute(*itm_itr, attribute_name);
+        }
+    }
+
+    //open ranks table, get item index, find rank
+    ranks_table ranks(get_self(), grp.group_name.value);
+    auto ranks_by_item = ranks.get_index<"byitem"_n>();
+    auto rnk_itr = ranks_by_item.find((uint128_t(serial) << 64) | attribute_name.value);
+
+    //if rank not found
+    if (rnk_itr == ranks_by_item.end()) {
+        if (points) {
+            //initialize
+            uint64_t new_rank_id = ranks.available_primary_key();
+
+            //emplace new rank
+            //ram payer: contract
+            ranks.emplace(get_self(), [&](auto& col) {
+                col.rank_id = new_rank_id;
+                col.serial = serial;
+                col.attribute_name = attribute_name;
+                col.points = *points;
+            });
+        }
+    } else if (!points) {
+        //erase rank
+        ranks_by_item.erase(rnk_itr);
+    } else if (rnk_itr->points != *points) {
+        //update rank
+        ranks_by_item.modify(rnk_itr, same_payer, [&](auto& col) {
+            col.points = *points;
+        });
+    }
+}
+
+void marble::clear_ranks(name group_name, uint64_t serial)
+{
+    //open ranks table, get item index
+    ranks_table ranks(get_self(), group_name.value);
+    auto ranks_by_item = ranks.get_index<"byitem"_n>();
+    auto rnk_itr = ranks_by_item.lower_bound(uint128_t(serial) << 64);
+
+    //erase ranks of item
+    while (rnk_itr != ranks_by_item.end() && rnk_itr->serial == serial) {
+        rnk_itr = ranks_by_item.erase(rnk_itr);
+    }
+}
+
+int64_t marble::add_points(int64_t points, int64_t delta)
+{
+    //initialize
+    int64_t new_points;
+
+    //validate
+    check(!__builtin_add_overflow(points, delta, &new_points), "attribute points overflow");
+
+    return new_points;
+}
+
+void marble::emplace_item_attributes(uint64_t serial, const group& grp, const map<name, int64_t>& attributes)
+{
+    //skip if no attributes
+    if (attributes.empty()) {
+        return;
+    }
+
+    //if packed attributes
+    if (grp.options.value_or() & PACKED_ATTRS_OPT) {
+        //open attribute packs table
+        attribute_packs_table packs(get_self(), get_self().value);
+
+        //emplace new pack, map is already sorted by attribute name
+        //ram payer: contract
+        packs.emplace(get_self(), [&](auto& col) {
+            col.serial = serial;
+            for (auto& a : attributes) {
+                col.attributes.push_back({a.first, a.second});
+            }
+            col.lock_bits.resize((attributes.size() + 7) / 8, 0);
+        });
+    } else {
+        //open attributes table
+        attributes_table attrs(get_self(), serial);
+
+        //emplace attributes
+        for (auto& a : attributes) {
+            //emplace new attribute
+            //ram payer: contract
+            attrs.emplace(get_self(), [&](auto& col) {
+                col.attribute_name = a.first;
+                col.points = a.second;
+                col.locked = false;
+            });
+        }
+    }
+
+    //update ranks
+    for (auto& a : attributes) {
+        sync_rank(grp, serial, a.first, a.second);
+    }
+}
+
+//======================== attribute queries ========================
+
+vector<marble::rank_entry> marble::getranks(name group_name, name attribute_name, int64_t min_points, int64_t max_points, uint16_t limit)
+{
+    //validate
+    check(limit > 0 && limit <= 1000, "limit must be between 1 and 1000");
+    check(min_points <= max_points, "min points must not exceed max points");
+
+    //initialize
+    vector<rank_entry> entries;
+    uint128_t lower_key = (uint128_t(attribute_name.value) << 64) | (uint64_t(min_points) ^ (uint64_t(1) << 63));
+    uint128_t upper_key = (uint128_t(attribute_name.value) << 64) | (uint64_t(max_points) ^ (uint64_t(1) << 63));
+
+    //open ranks table, get points index
+    ranks_table ranks(get_self(), group_name.value);
+    auto ranks_by_points = ranks.get_index<"bypoints"_n>();
+    auto itr = ranks_by_points.upper_bound(upper_key);
+
+    //walk down from highest points in range
+    while (itr != ranks_by_points.begin() && entries.size() < limit) {
+        itr--;
+
+        //if below range
+        if (itr->by_points() < lower_key) {
+            break;
+        }
+
+        entries.push_back({itr->serial, itr->points});
+    }
+
+    return entries;
 }
@@ -2,9 +2,6 @@
 
 ACTION marble::newbond(uint64_t serial, asset amount, optional<name> release_event)
 {
-    //validate
-    check(amount.symbol == CORE_SYM, "asset must be core symbol");
-
     //open items table, get item
     items_table items(get_self(), get_self().value);
     auto& itm = items.get(serial, "item not found");
@@ -16,18 +13,11 @@ ACTION marble::newbond(uint64_t serial, asset amount, optional<name> release_eve
     //authenticate
     require_auth(grp.manager);
 
-    //open wallets table, get manager wallet
-    wallets_table wallets(get_self(), grp.manager.value);
-    auto& mgr_wall = wallets.get(amount.symbol.code().raw(), "manager wallet not found");
-
     //validate
-    check(mgr_wall.balance >= amount, "insufficient funds");
     check(amount.amount > 0, "must back with a positive amount");
 
-    //subtract from wallet balance
-    wallets.modify(mgr_wall, same_payer, [&](auto& col) {
-        col.balance -= amount;
-    });
+    //subtract from manager wallet balance
+    debit_wallet(grp.manager, amount);
 
     //open bonds table, search for bond
     bonds_table bonds(get_self(), serial);
@@ -41,12 +31,15 @@ ACTION marble::newbond(uint64_t serial, asset amount, optional<name> release_eve
 
     //if release event not blank
     if (bond_release_event != name(0)) {
-        //open events table, get event
-        events_table events(get_self(), serial);
-        auto& evnt = events.get(bond_release_event.value, "release event not found");
+        //get release time
+        auto release_time = get_release_time(serial, itm.group, bond_release_event);
 
         //validate
-        check(evnt.event_time > time_point_sec(current_time_point()), "release event time must be in the future");
+        check(release_time.has_value(), "release event not found");
+        check(*release_time > time_point_sec(current_time_point()), "release event time must be in the future");
+
+        //add bond to release index
+        index_release(serial, amount.symbol.code(), *release_time);
     }
 
     //emplace new bond
@@ -56,13 +49,95 @@ ACTION marble::newbond(uint64_t serial, asset amount, optional<name> release_eve
         col.release_event = bond_release_event;
         col.locked = false;
     });
+    //count new bond
+    count_bonds(amount.symbol.code(), 1);
 }
 
-ACTION marble::addtobond(uint64_t serial, asset amount)
+ACTION marble::newbonds(vector<uint64_t> serials, asset per_item, optional<name> release_event)
 {
     //validate
-    check(amount.symbol == CORE_SYM, "asset must be core symbol");
+    check(per_item.amount > 0, "must back with a positive amount");
+    check(serials.size() > 0, "must back at least one item");
+
+    //validate no duplicate serials
+    vector<uint64_t> sorted_serials = serials;
+    sort(sorted_serials.begin(), sorted_serials.end());
+    check(adjacent_find(sorted_serials.begin(), sorted_serials.end()) == sorted_serials.end(), "duplicate serials in batch");
+
+    //initialize
+    time_point_sec now = time_point_sec(current_time_point());
+    name bond_release_event = (release_event) ? *release_event : name(0);
+    name manager = name(0);
+    map<name, optional<time_point_sec>> shared_release_times; //group_name => shared release event time
+
+    //open items and groups tables
+    items_table items(get_self(), get_self().value);
+    groups_table groups(get_self(), get_self().value);
+
+    for (uint64_t s : serials) {
+        //get item
+        auto& itm = items.get(s, "item not found");
+
+        //if group not checked yet
+        if (shared_release_times.find(itm.group) == shared_release_times.end()) {
+            //get group
+            auto& grp = groups.get(itm.group.value, "group not found");
+
+            //if first group
+            if (manager == name(0)) {
+                //authenticate
+                require_auth(grp.manager);
+                manager = grp.manager;
+            } else {
+                //validate
+                check(grp.manager == manager, "all items must have the same manager");
+            }
+
+            //cache shared release time once per group
+            shared_release_times[itm.group] = (bond_release_event != name(0)) ? get_shared_release_time(itm.group, bond_release_event) : optional<time_point_sec>();
+        }
+
+        //open bonds table, search for bond
+        bonds_table bonds(get_self(), s);
+        auto bond_itr = bonds.find(per_item.symbol.code().raw());
+
+        //validate
+        check(bond_itr == bonds.end(), "bond already exists");
+
+        //if release event not blank
+        if (bond_release_event != name(0)) {
+            //get release time, item event overrides shared event
+            auto release_time = get_release_time(s, bond_release_event, shared_release_times[itm.group]);
+
+            //validate
+            check(release_time.has_value(), "release event not found");
+            check(*release_time > now, "release event time must be in the future");
+
+            //add bond to release index
+            index_release(s, per_item.symbol.code(), *release_time);
+        }
+
+        //emplace new bond
+        //ram payer: contract
+        bonds.emplace(get_self(), [&](auto& col) {
+            col.backed_amount = per_item;
+            col.release_event = bond_release_event;
+            col.locked = false;
+        });
+    }
+
+    //initialize
+    asset total = per_item * int64_t(serials.size());
+
+    //subtract total from manager wallet balance once
+    debit_wallet(manager, total);
+
+    //count new bonds
+    count_bonds(per_item.symbol.code(), serials.size());
+}
 
+ACTION marble::addtobond(uint64_t serial, asset amount)
+{
     //open items table, get item
     items_table items(get_self(), get_self().value);
     auto& itm = items.get(serial, "item not found");
@@ -74,18 +149,11 @@ ACTION marble::addtobond(uint64_t serial, asset amount)
     //authenticate
     require_auth(grp.manager);
 
-    //open wallets table, get manager wallet
-    wallets_table wallets(get_self(), grp.manager.value);
-    auto& mgr_wall = wallets.get(amount.symbol.code().raw(), "manager wallet not found");
-
     //validate
-    check(mgr_wall.balance >= amount, "insufficient funds");
     check(amount.amount > 0, "must back with a positive amount");
 
-    //subtract from wallet balance
-    wallets.modify(mgr_wall, same_payer, [&](auto& col) {
-        col.balance -= amount;
-    });
+    //subtract from manager wallet balance
+    debit_wallet(grp.manager, amount);
 
     //open bonds table, search for bond
     bonds_table bonds(get_self(), serial);
@@ -100,6 +168,51 @@ ACTION marble::addtobond(uint64_t serial, asset amount)
     });
 }
 
+ACTION marble::newvesting(uint64_t serial, asset amount, uint16_t steps, uint32_t step_period, optional<time_point_sec> start_time)
+{
+    //validate
+    check(amount.amount > 0, "must back with a positive amount");
+    check(steps > 0, "must vest in at least one step");
+    check(step_period > 0, "step period must be greater than zero");
+    check(amount.amount >= steps, "amount too small for number of steps");
+
+    //open items table, get item
+    items_table items(get_self(), get_self().value);
+    auto& itm = items.get(serial, "item not found");
+
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(itm.group.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //subtract from manager wallet balance
+    debit_wallet(grp.manager, amount);
+
+    //open bonds table, search for bond
+    bonds_table bonds(get_self(), serial);
+    auto bond_itr = bonds.find(amount.symbol.code().raw());
+
+    //validate
+    check(bond_itr == bonds.end(), "bond already exists");
+
+    //emplace new vesting bond
+    //ram payer: contract
+    bonds.emplace(get_self(), [&](auto& col) {
+        col.backed_amount = amount;
+        col.release_event = name(0);
+        col.locked = false;
+        col.start_time.emplace((start_time) ? *start_time : time_point_sec(current_time_point()));
+        col.step_period.emplace(step_period);
+        col.steps.emplace(steps);
+        col.claimed_steps.emplace(0);
+        col.per_step.emplace(asset(amount.amount / steps, amount.symbol));
+    });
+    //count new bond
+    count_bonds(amount.symbol.code(), 1);
+}
+
 ACTION marble::release(uint64_t serial)
 {
     //open items table, get item
@@ -109,43 +222,55 @@ ACTION marble::release(uint64_t serial)
     //authenticate
     require_auth(itm.owner);
 
-    //open bonds table, get bond
-    bonds_table bonds(get_self(), serial);
-    auto& bnd = bonds.get(CORE_SYM.code().raw(), "bond not found");
+    //initialize
+    map<symbol_code, asset> release_totals; //bond symbol => released amount
+
+    //claim matured amounts from each item bond
+    claim_bonds(itm, time_point_sec(current_time_point()), release_totals);
+
+    //validate
+    check(release_totals.size() > 0, "no matured bonds to release");
+
+    //release matured amounts to item owner
+    credit_wallets(itm.owner, release_totals);
+}
+
+ACTION marble::releasemany(name owner, vector<uint64_t> serials)
+{
+    //authenticate
+    require_auth(owner);
 
     //validate
-    check(bnd.release_event != name(0), "bond must have a release event to manually release");
+    check(serials.size() > 0, "must release at least one bond");
+
+    //validate no duplicate serials
+    vector<uint64_t> sorted_serials = serials;
+    sort(sorted_serials.begin(), sorted_serials.end());
+    check(adjacent_find(sorted_serials.begin(), sorted_serials.end()) == sorted_serials.end(), "duplicate serials in batch");
 
     //initialize
     time_point_sec now = time_point_sec(current_time_point());
+    map<symbol_code, asset> release_totals; //bond symbol => released amount
 
-    //open events table, get event
-    events_table events(get_self(), serial);
-    auto& evnt = events.get(bnd.release_event.value, "event not found");
+    //open items table
+    items_table items(get_self(), get_self().value);
 
-    //validate
-    check(now >= evnt.event_time, "bond can only be released after release event time");
+    for (uint64_t s : serials) {
+        //get item
+        auto& itm = items.get(s, "item not found");
 
-    //open wallets table, search for wallet
-    wallets_table wallets(get_self(), itm.owner.value);
-    auto wall_itr = wallets.find(CORE_SYM.code().raw());
+        //validate
+        check(itm.owner == owner, "owner doesn't own item");
 
-    //if wallet found
-    if (wall_itr != wallets.end()) {
-        //add to existing wallet
-        wallets.modify(*wall_itr, same_payer, [&](auto& col) {
-            col.balance += bnd.backed_amount;
-        });
-    } else {
-        //create new wallet
-        //ram payer: contract
-        wallets.emplace(get_self(), [&](auto& col) {
-            col.balance = bnd.backed_amount;
-        });
+        //add matured amounts to release totals
+        claim_bonds(itm, now, release_totals);
     }
 
-    //erase bond
-    bonds.erase(bnd);
+    //validate
+    check(release_totals.size() > 0, "no matured bonds to release");
+
+    //credit owner wallets once per currency
+    credit_wallets(owner, release_totals);
 }
 
 ACTION marble::releaseall(uint64_t serial, name release_to)
@@ -154,33 +279,23 @@ ACTION marble::releaseall(uint64_t serial, name release_to)
     // require_auth(permission_level{get_self(), name("releases")});
     require_auth(get_self());
 
-    //open bonds table, get bond
+    //open bonds table
     bonds_table bonds(get_self(), serial);
-    auto& bnd = bonds.get(CORE_SYM.code().raw(), "bond not found");
 
-    //open wallets table, search for wallet
-    wallets_table wallets(get_self(), release_to.value);
-    auto wall_itr = wallets.find(CORE_SYM.code().raw());
-
-    //if wallet found
-    if (wall_itr != wallets.end()) {
-        //add to existing wallet
-        wallets.modify(*wall_itr, same_payer, [&](auto& col) {
-            col.balance += bnd.backed_amount;
-        });
-    } else {
-        //create new wallet
-        //ram payer: contract
-        wallets.emplace(get_self(), [&](auto& col) {
-            col.balance = bnd.backed_amount;
-        });
-    }
+    //validate
+    check(bonds.begin() != bonds.end(), "bond not found");
 
-    //erase bond
-    bonds.erase(bnd);
+    //settle all bonds to release account
+    settle_bonds(serial, release_to);
 }
 
 ACTION marble::lockbond(uint64_t serial)
+{
+    //lock core currency bond
+    lockbondsym(serial, CORE_SYM.code());
+}
+
+ACTION marble::lockbondsym(uint64_t serial, symbol_code bond_sym)
 {
     //open items table, get item
     items_table items(get_self(), get_self().value);
@@ -195,7 +310,7 @@ ACTION marble::lockbond(uint64_t serial)
 
     //open bonds table, get bond
     bonds_table bonds(get_self(), serial);
-    auto& bnd = bonds.get(CORE_SYM.code().raw(), "bond not found");
+    auto& bnd = bonds.get(bond_sym.raw(), "bond not found");
 
     //validate
     check(!bnd.locked, "bond is already locked");
@@ -205,3 +320,378 @@ ACTION marble::lockbond(uint64_t serial)
         col.locked = true;
     });
 }
+
+ACTION marble::crank(uint16_t max)
+{
+    //validate
+    check(max > 0, "max must be greater than zero");
+
+    //initialize
+    time_point_sec now = time_point_sec(current_time_point());
+    uint16_t processed = 0;
+    map<name, map<symbol_code, asset>> payouts; //owner => bond symbol => released bond total
+
+    //open releases and items tables
+    releases_table releases(get_self(), get_self().value);
+    auto releases_by_time = releases.get_index<"bytime"_n>();
+    items_table items(get_self(), get_self().value);
+
+    //walk due releases in time order
+    auto rel_itr = releases_by_time.begin();
+    while (rel_itr != releases_by_time.end() && rel_itr->release_time <= now && processed < max) {
+        //count processed release
+        processed++;
+
+        //open bonds table, find bond
+        bonds_table bonds(get_self(), rel_itr->serial);
+        auto bond_itr = bonds.find(rel_itr->bond_sym.raw());
+
+        //if bond or item gone
+        auto itm_itr = items.find(rel_itr->serial);
+        if (bond_itr == bonds.end() || itm_itr == items.end()) {
+            //erase stale release
+            rel_itr = releases_by_time.erase(rel_itr);
+            continue;
+        }
+
+        //get release time
+        auto release_time = get_release_time(rel_itr->serial, itm_itr->group, bond_itr->release_event);
+
+        //if release event removed
+        if (!release_time) {
+            //erase stale release, bond stays claimable if event is recreated
+            rel_itr = releases_by_time.erase(rel_itr);
+            continue;
+        }
+
+        //if release event moved into the future
+        if (*release_time > now) {
+            //move release, advance first since its index position changes
+            auto moved_itr = rel_itr++;
+            releases_by_time.modify(moved_itr, same_payer, [&](auto& col) {
+                col.release_time = *release_time;
+            });
+            continue;
+        }
+
+        //add to owner payout
+        auto& owner_payouts = payouts[itm_itr->owner];
+        auto pay_itr = owner_payouts.find(rel_itr->bond_sym);
+        if (pay_itr == owner_payouts.end()) {
+            owner_payouts.emplace(rel_itr->bond_sym, bond_itr->backed_amount);
+        } else {
+            pay_itr->second += bond_itr->backed_amount;
+        }
+
+        //erase bond and release
+        bonds.erase(bond_itr);
+        count_bonds(rel_itr->bond_sym, -1);
+        rel_itr = releases_by_time.erase(rel_itr);
+    }
+
+    //validate
+    check(processed > 0, "no bonds due for release");
+
+    //credit owner wallets once per currency
+    for (auto& p : payouts) {
+        credit_wallets(p.first, p.second);
+    }
+}
+
+//======================== bond functions ========================
+
+void marble::index_release(uint64_t serial, symbol_code bond_sym, time_point_sec release_time)
+{
+    //open releases table, get bond index, find release
+    releases_table releases(get_self(), get_self().value);
+    auto releases_by_bond = releases.get_index<"bybond"_n>();
+    auto rel_itr = releases_by_bond.find((uint128_t(serial) << 64) | bond_sym.raw());
+
+    //if release found
+    if (rel_itr != releases_by_bond.end()) {
+        //update release time
+        releases_by_bond.modify(rel_itr, same_payer, [&](auto& col) {
+            col.release_time = release_time;
+        });
+    } else {
+        //initialize
+        uint64_t new_release_id = releases.available_primary_key();
+
+        //emplace new release
+        //ram payer: contract
+        releases.emplace(get_self(), [&](auto& col) {
+            col.release_id = new_release_id;
+            col.serial = serial;
+            col.bond_sym = bond_sym;
+            col.release_time = release_time;
+        });
+    }
+}
+
+void marble::unindex_release(uint64_t serial, symbol_code bond_sym)
+{
+    //open releases table, get bond index, find release
+    releases_table releases(get_self(), get_self().value);
+    auto releases_by_bond = releases.get_index<"bybond"_n>();
+    auto rel_itr = releases_by_bond.find((uint128_t(serial) << 64) | bond_sym.raw());
+
+    //if release found
+    if (rel_itr != releases_by_bond.end()) {
+        //erase release
+        releases_by_bond.erase(rel_itr);
+    }
+}
+
+asset marble::take_bond(uint64_t serial, bonds_table& bonds, bonds_table::const_iterator bond_itr)
+{
+    //initialize
+    asset bond_amount = bond_itr->backed_amount;
+
+    //remove bond from release index
+    if (bond_itr->release_event != name(0)) {
+        unindex_release(serial, bond_amount.symbol.code());
+    }
+
+    //erase bond
+    bonds.erase(bond_itr);
+    count_bonds(bond_amount.symbol.code(), -1);
+
+    return bond_amount;
+}
+
+optional<time_point_sec> marble::get_release_time(uint64_t serial, name group_name, name release_event)
+{
+    //open events table, find event
+    events_table events(get_self(), serial);
+    auto evnt_itr = events.find(release_event.value);
+
+    //if item event found
+    if (evnt_itr != events.end()) {
+        return evnt_itr->event_time;
+    }
+
+    return get_shared_release_time(group_name, release_event);
+}
+
+optional<time_point_sec> marble::get_release_time(uint64_t serial, name release_event, optional<time_point_sec> shared_time)
+{
+    //open events table, find event
+    events_table events(get_self(), serial);
+    auto evnt_itr = events.find(release_event.value);
+
+    //if item event found
+    if (evnt_itr != events.end()) {
+        return evnt_itr->event_time;
+    }
+
+    return shared_time;
+}
+
+optional<time_point_sec> marble::get_shared_release_time(name group_name, name release_event)
+{
+    //open shared events table, find shared event
+    shared_events_table shared_events(get_self(), group_name.value);
+    auto sh_evnt_itr = shared_events.find(release_event.value);
+
+    //if shared event found
+    if (sh_evnt_itr != shared_events.end()) {
+        return sh_evnt_itr->event_time;
+    }
+
+    return {};
+}
+
+vector<marble::bond_release> marble::shared_releases(name group_name, name release_event, time_point_sec event_time)
+{
+    //initialize
+    vector<bond_release> found;
+
+    //open releases table, get time index
+    releases_table releases(get_self(), get_self().value);
+    auto releases_by_time = releases.get_index<"bytime"_n>();
+    auto rel_itr = releases_by_time.lower_bound(uint128_t(event_time.sec_since_epoch()) << 64);
+
+    //open items table
+    items_table items(get_self(), get_self().value);
+
+    //walk releases indexed at shared event time
+    for (; rel_itr != releases_by_time.end() && rel_itr->release_time == event_time; rel_itr++) {
+        //find item
+        auto itm_itr = items.find(rel_itr->serial);
+
+        //skip items outside group
+        if (itm_itr == items.end() || itm_itr->group != group_name) {
+            continue;
+        }
+
+        //open bonds table, find bond
+        bonds_table bonds(get_self(), rel_itr->serial);
+        auto bond_itr = bonds.find(rel_itr->bond_sym.raw());
+
+        //skip bonds released by another event
+        if (bond_itr == bonds.end() || bond_itr->release_event != release_event) {
+            continue;
+        }
+
+        //open events table
+        events_table events(get_self(), rel_itr->serial);
+
+        //skip items overriding shared event with an item event
+        if (events.find(release_event.value) != events.end()) {
+            continue;
+        }
+
+        found.push_back(*rel_itr);
+    }
+
+    return found;
+}
+
+asset marble::claim_bond(const item& itm, bonds_table& bonds, bonds_table::const_iterator bond_itr, time_point_sec now)
+{
+    //if vesting bond
+    if (bond_itr->steps.value_or() > 0) {
+        //initialize
+        time_point_sec start_time = bond_itr->start_time.value();
+        uint16_t steps = bond_itr->steps.value();
+        uint16_t claimed_steps = bond_itr->claimed_steps.value();
+        uint64_t elapsed = (now > start_time) ? now.sec_since_epoch() - start_time.sec_since_epoch() : 0;
+        uint16_t vested_steps = std::min<uint64_t>(elapsed / bond_itr->step_period.value(), steps);
+
+        //if no new steps vested
+        if (vested_steps <= claimed_steps) {
+            return asset(0, bond_itr->backed_amount.symbol);
+        }
+
+        //if final step vested
+        if (vested_steps == steps) {
+            //release remainder
+            return take_bond(itm.serial, bonds, bond_itr);
+        }
+
+        //initialize
+        asset step_amount = bond_itr->per_step.value() * (vested_steps - claimed_steps);
+
+        //update bond
+        bonds.modify(bond_itr, same_payer, [&](auto& col) {
+            col.backed_amount -= step_amount;
+            col.claimed_steps.value() = vested_steps;
+        });
+
+        return step_amount;
+    }
+
+    //if no release event
+    if (bond_itr->release_event == name(0)) {
+        return asset(0, bond_itr->backed_amount.symbol);
+    }
+
+    //get release time
+    auto release_time = get_release_time(itm.serial, itm.group, bond_itr->release_event);
+
+    //if release event not found or not reached
+    if (!release_time || now < *release_time) {
+        return asset(0, bond_itr->backed_amount.symbol);
+    }
+
+    //release full bond
+    return take_bond(itm.serial, bonds, bond_itr);
+}
+
+void marble::claim_bonds(const item& itm, time_point_sec now, map<symbol_code, asset>& totals)
+{
+    //open bonds table
+    bonds_table bonds(get_self(), itm.serial);
+
+    //loop over item bonds, advance first since claimed bonds may be erased
+    auto bond_itr = bonds.begin();
+    while (bond_itr != bonds.end()) {
+        //claim matured amount
+        asset claimed = claim_bond(itm, bonds, bond_itr++, now);
+
+        //if amount claimed
+        if (claimed.amount > 0) {
+            //add to currency total
+            auto tot_itr = totals.find(claimed.symbol.code());
+            if (tot_itr == totals.end()) {
+                totals.emplace(claimed.symbol.code(), claimed);
+            } else {
+                tot_itr->second += claimed;
+            }
+        }
+    }
+}
+
+void marble::take_bonds(uint64_t serial, map<symbol_code, asset>& totals)
+{
+    //open bonds table
+    bonds_table bonds(get_self(), serial);
+
+    //loop over item bonds, advance first since taken bonds are erased
+    auto bond_itr = bonds.begin();
+    while (bond_itr != bonds.end()) {
+        //erase bond
+        asset bond_amount = take_bond(serial, bonds, bond_itr++);
+
+        //add to currency total
+        auto tot_itr = totals.find(bond_amount.symbol.code());
+        if (tot_itr == totals.end()) {
+            totals.emplace(bond_amount.symbol.code(), bond_amount);
+        } else {
+            tot_itr->second += bond_amount;
+        }
+    }
+}
+
+void marble::fund_bond(uint64_t serial, asset amount, name funder)
+{
+    //open items table, get item
+    items_table items(get_self(), get_self().value);
+    auto& itm = items.get(serial, "item not found");
+
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(itm.group.value, "group not found");
+
+    //validate
+    check(funder == grp.manager, "only group manager can fund bonds");
+    check(amount.amount > 0, "must back with a positive amount");
+
+    //open bonds table, search for bond
+    bonds_table bonds(get_self(), serial);
+    auto bond_itr = bonds.find(amount.symbol.code().raw());
+
+    //if bond found
+    if (bond_itr != bonds.end()) {
+        //validate
+        check(!bond_itr->locked, "bond cannot be modified if locked");
+
+        //update bond
+        bonds.modify(bond_itr, same_payer, [&](auto& col) {
+            col.backed_amount += amount;
+        });
+    } else {
+        //emplace new bond
+        //ram payer: contract
+        bonds.emplace(get_self(), [&](auto& col) {
+            col.backed_amount = amount;
+            col.release_event = name(0);
+            col.locked = false;
+        });
+
+        //count new bond
+        count_bonds(amount.symbol.code(), 1);
+    }
+}
+
+void marble::settle_bonds(uint64_t serial, name release_to)
+{
+    //initialize
+    map<symbol_code, asset> bond_totals; //bond symbol => backed amount
+
+    //erase all item bonds
+    take_bonds(serial, bond_totals);
+
+    //credit wallets with bond amounts
+    credit_wallets(release_to, bond_totals);
+}
@@ -48,6 +48,14 @@ ACTION marble::newevent(uint64_t serial, name event_name, optional<time_point_se
             col.event_time = new_event_time;
             col.locked = false;
         });
+
+        //move bonds released by event in release index, item event overrides shared event
+        bonds_table bonds(get_self(), serial);
+        for (auto& b : bonds) {
+            if (b.release_event == event_name) {
+                index_release(serial, b.backed_amount.symbol.code(), new_event_time);
+            }
+        }
     }
 }
 
@@ -73,10 +81,18 @@ ACTION marble::seteventtime(uint64_t serial, name event_name, time_point_sec new
         //validate
         check(!se.locked, "shared event is locked");
 
+        //initialize
+        auto released = shared_releases(grp.group_name, event_name, se.event_time);
+
         //update shared event
         shared_events.modify(se, same_payer, [&](auto& col) {
             col.event_time = new_event_time;
         });
+
+        //move bonds released by shared event in release index
+        for (auto& r : released) {
+            index_release(r.serial, r.bond_sym, new_event_time);
+        }
     } else {
         //open events table, get event
         events_table events(get_self(), serial);
@@ -89,6 +105,14 @@ ACTION marble::seteventtime(uint64_t serial, name event_name, time_point_sec new
         events.modify(e, same_payer, [&](auto& col) {
             col.event_time = new_event_time;
         });
+
+        //move bonds released by event in release index
+        bonds_table bonds(get_self(), serial);
+        for (auto& b : bonds) {
+            if (b.release_event == event_name) {
+                index_release(serial, b.backed_amount.symbol.code(), new_event_time);
+            }
+        }
     }
 }
 
@@ -148,6 +172,9 @@ ACTION marble::rmvevent(uint64_t serial, name group_name, name event_name, bool
         shared_events_table shared_events(get_self(), grp.group_name.value);
         auto& se = shared_events.get(event_name.value, "shared event not found");
 
+        //validate
+        check(shared_releases(grp.group_name, event_name, se.event_time).empty(), "shared event is a bond release event");
+
         //erase shared event
         shared_events.erase(se);
     } else {
@@ -155,6 +182,12 @@ ACTION marble::rmvevent(uint64_t serial, name group_name, name event_name, bool
         events_table events(get_self(), serial);
         auto& e = events.get(event_name.value, "event not found");
 
+        //validate
+        bonds_table bonds(get_self(), serial);
+        for (auto& b : bonds) {
+            check(b.release_event != event_name, "event is a bond release event");
+        }
+
         //erase event
         events.erase(e);
     }
@@ -165,3 +198,85 @@ ACTION marble::logevent(name event_name, int64_t event_value, time_point_sec eve
     //authenticate
     require_auth(get_self()); //TODO: permission_level{get_self(), name("log")}
 }
+
+ACTION marble::logrange(name event_name, name group_name, uint64_t first_serial, uint64_t last_serial, time_point_sec event_time)
+{
+    //authenticate
+    require_auth(get_self());
+}
+
+ACTION marble::setemitmode(name group_name, name mode)
+{
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(group_name.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //migrate group
+    migrate_group(groups, grp);
+
+    //initialize
+    uint8_t mode_opts = 0;
+
+    switch (mode.value) {
+        case name("inline").value:
+            break;
+        case name("aggregate").value:
+            mode_opts = EMIT_AGGREGATE_OPT;
+            break;
+        case name("off").value:
+            mode_opts = EMIT_OFF_OPT;
+            break;
+        default:
+            check(false, "invalid emission mode");
+    }
+
+    //update group options
+    groups.modify(grp, same_payer, [&](auto& col) {
+        col.options.value() = (col.options.value() & ~(EMIT_AGGREGATE_OPT | EMIT_OFF_OPT)) | mode_opts;
+    });
+}
+
+//======================== event functions ========================
+
+void marble::emit_event(const group& grp, name event_name, uint64_t serial, string memo)
+{
+    //skip if emission off
+    if (grp.options.value_or() & EMIT_OFF_OPT) {
+        return;
+    }
+
+    //if aggregate emission
+    if (grp.options.value_or() & EMIT_AGGREGATE_OPT) {
+        emit_range(grp, event_name, serial, 1);
+        return;
+    }
+
+    //inline logevent
+    action(permission_level{get_self(), name("active")}, get_self(), name("logevent"), make_tuple(
+        event_name, //event_name
+        int64_t(serial), //event_value
+        time_point_sec(current_time_point()), //event_time
+        memo, //memo
+        false //shared
+    )).send();
+}
+
+void marble::emit_range(const group& grp, name event_name, uint64_t first_serial, uint64_t count)
+{
+    //skip if emission off
+    if (grp.options.value_or() & EMIT_OFF_OPT) {
+        return;
+    }
+
+    //inline logrange
+    action(permission_level{get_self(), name("active")}, get_self(), name("logrange"), make_tuple(
+        event_name, //event_name
+        grp.group_name, //group_name
+        first_serial, //first_serial
+        first_serial + count - 1, //last_serial
+        time_point_sec(current_time_point()) //event_time
+    )).send();
+}
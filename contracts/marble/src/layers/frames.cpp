@@ -23,6 +23,29 @@ ACTION marble::newframe(name frame_name, name group, map<name, string> default_t
         col.group = group;
         col.default_tags = default_tags;
         col.default_attributes = default_attributes;
+        col.inherit.emplace(false);
+    });
+}
+
+ACTION marble::inheritframe(name frame_name)
+{
+    //open frames table, get frame
+    frames_table frames(get_self(), get_self().value);
+    auto& frm = frames.get(frame_name.value, "frame not found");
+
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(frm.group.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //validate
+    check(!frm.inherit.value_or(false), "frame is already inherited");
+
+    //update frame
+    frames.modify(frm, same_payer, [&](auto& col) {
+        col.inherit.emplace(true);
     });
 }
 
@@ -39,6 +62,56 @@ ACTION marble::applyframe(name frame_name, uint64_t serial, bool overwrite)
     //authenticate
     require_auth(grp.manager);
 
+    //open items table, get item
+    items_table items(get_self(), get_self().value);
+    auto& itm = items.get(serial, "item not found");
+
+    //validate
+    check(itm.group == frm.group, "item is not in frame group");
+
+    //if frame is inherited
+    if (frm.inherit.value_or(false)) {
+        //validate
+        check(itm.frame.value_or() == name(0) || itm.frame.value_or() == frame_name, "item already inherits from another frame");
+
+        //link item to frame
+        if (itm.frame.value_or() != frame_name) {
+            items.modify(itm, same_payer, [&](auto& col) {
+                col.frame.emplace(frame_name);
+            });
+        }
+
+        //NOTE: existing rows override frame defaults, erase them if overwrite is true
+        if (overwrite) {
+            //open tags table
+            tags_table tags(get_self(), serial);
+
+            //erase overriding tags
+            for (auto& t : frm.default_tags) {
+                auto tg_itr = tags.find(t.first.value);
+                if (tg_itr != tags.end()) {
+                    check(!tg_itr->locked, "tag is locked");
+                    release_blob(tg_itr->blob_id.value_or());
+                    tags.erase(tg_itr);
+                }
+            }
+
+            //erase overriding attributes
+            for (auto& a : frm.default_attributes) {
+                auto attr = get_item_attribute(itm, grp, a.first);
+                if (attr && attr->stored) {
+                    check(!attr->locked, "attribute is locked");
+                    erase_item_attribute(serial, grp, a.first);
+                }
+            }
+        }
+
+        //rank inherited attributes
+        rank_defaults(frm, grp, itm);
+
+        return;
+    }
+
     //apply default tags
     for (auto itr = frm.default_tags.begin(); itr != frm.default_tags.end(); itr++) {
         //open tags table, find tag
@@ -49,11 +122,15 @@ ACTION marble::applyframe(name frame_name, uint64_t serial, bool overwrite)
 
         //if tag not found
         if (tg_itr == tags.end()) {
+            //initialize
+            uint64_t content_blob = retain_blob(sha256(itr->second.data(), itr->second.size()), itr->second, 1);
+
             //emplace new tag
             //ram payer: self
             tags.emplace(get_self(), [&](auto& col) {
                 col.tag_name = itr->first;
-                col.content = itr->second;
+                col.content = "";
+                col.blob_id.emplace(content_blob);
                 col.checksum = "";
                 col.algorithm = "";
             });
@@ -61,9 +138,17 @@ ACTION marble::applyframe(name frame_name, uint64_t serial, bool overwrite)
             //validate
             check(!tg_itr->locked, "tag is locked");
 
+            //initialize
+            uint64_t old_blob = tg_itr->blob_id.value_or();
+            uint64_t content_blob = retain_blob(sha256(itr->second.data(), itr->second.size()), itr->second, 1);
+
+            //release old content
+            release_blob(old_blob);
+
             //overwrite existing tag
             tags.modify(tg_itr, same_payer, [&](auto& col) {
-                col.content = itr->second;
+                col.content = "";
+                col.blob_id.emplace(content_blob);
                 col.checksum = "";
                 col.algorithm = "";
             });
@@ -72,28 +157,21 @@ ACTION marble::applyframe(name frame_name, uint64_t serial, bool overwrite)
 
     //apply default attributes
     for (auto itr = frm.default_attributes.begin(); itr != frm.default_attributes.end(); itr++) {
-        //open attributes table, find attribute
-        attributes_table attributes(get_self(), serial);
-        auto attr_itr = attributes.find(itr->first.value);
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, itr->first);
 
         //NOTE: will skip existing attribute with same attribute name if overwrite is false
 
-        //if attribute not found
-        if (attr_itr == attributes.end()) {
-            //emplace new attribute
-            //ram payer: self
-            attributes.emplace(get_self(), [&](auto& col) {
-                col.attribute_name = itr->first;
-                col.points = itr->second;
-            });
+        //if attribute not stored
+        if (!attr || !attr->stored) {
+            //write new attribute
+            put_item_attribute(serial, grp, itr->first, itr->second, false);
         } else if (overwrite) {
             //validate
-            check(!attr_itr->locked, "attribute is locked");
+            check(!attr->locked, "attribute is locked");
 
             //overwrite existing attribute
-            attributes.modify(attr_itr, same_payer, [&](auto& col) {
-                col.points = itr->second;
-            });
+            put_item_attribute(serial, grp, itr->first, itr->second, false);
         }
     }
 }
@@ -111,116 +189,110 @@ ACTION marble::quickbuild(name frame_name, name to, map<name, string> override_t
     //authenticate
     require_auth(grp.manager);
 
-    //open config table, get config
-    config_table configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //migrate group
+    migrate_group(groups, grp);
+
+    //validate
+    check(grp.behavior_states.value() & MINT_FLAG, "item is not mintable");
+    check(is_account(to), "to account doesn't exist");
+    check(grp.supply < grp.supply_cap, "supply cap reached");
+
+    //resolve frame defaults and overrides
+    resolve_frame(frm, override_tags, override_attributes);
 
     //initialize
-    uint64_t item_serial = conf.last_serial + 1;
+    uint64_t new_serial = reserve_serials(groups, grp, 1);
 
-    //queue inline mintitem()
-    action(permission_level{get_self(), name("active")}, get_self(), name("mintitem"), make_tuple(
-        to, //to
-        frm.group //group_name
-    )).send();
+    //open items table
+    items_table items(get_self(), get_self().value);
 
-    //apply default tags
-    for (auto itr = frm.default_tags.begin(); itr != frm.default_tags.end(); itr++) {
-        //open tags table, search for tag
-        tags_table tags(get_self(), item_serial);
-        auto tg_itr = tags.find(itr->first.value);
+    //emplace new item
+    //ram payer: self
+    auto itm_itr = items.emplace(get_self(), [&](auto& col) {
+        col.serial = new_serial;
+        col.group = frm.group;
+        col.owner = to;
+        col.frame.emplace((frm.inherit.value_or(false)) ? frame_name : name(0));
+    });
 
-        //if tag not found
-        if (tg_itr == tags.end()) {
-            //emplace new tag
-            //ram payer: contract
-            tags.emplace(get_self(), [&](auto& col) {
-                col.tag_name = itr->first;
-                col.content = itr->second;
-                col.checksum = "";
-                col.algorithm = "";
-            });
-        } else {
-            //overwrite existing tag
-            tags.modify(tg_itr, same_payer, [&](auto& col) {
-                col.content = itr->second;
-                col.checksum = "";
-                col.algorithm = "";
-            });
-        }
+    //write tags and attributes
+    decorate_item(new_serial, grp, retain_blobs(override_tags, 1), override_attributes);
+
+    //rank inherited attributes
+    if (frm.inherit.value_or(false)) {
+        rank_defaults(frm, grp, *itm_itr);
     }
 
-    //apply default attributes
-    for (auto itr = frm.default_attributes.begin(); itr != frm.default_attributes.end(); itr++) {
-        //open attributes table, find attribute
-        attributes_table attributes(get_self(), item_serial);
-        auto attr_itr = attributes.find(itr->first.value);
-
-        //if attribute not found
-        if (attr_itr == attributes.end()) {
-            //emplace new attribute
-            //ram payer: contract
-            attributes.emplace(get_self(), [&](auto& col) {
-                col.attribute_name = itr->first;
-                col.points = itr->second;
-            });
-        } else {
+    //emit mint event
+    emit_event(grp, "mint"_n, new_serial, "serial: " + to_string(new_serial));
+}
 
-            //overwrite existing attribute
-            attributes.modify(attr_itr, same_payer, [&](auto& col) {
-                col.points = itr->second;
-            });
-        }
-    }
+ACTION marble::quickbuildn(name frame_name, vector<name> recipients, map<name, string> override_tags, map<name, int64_t> override_attributes)
+{
+    //open frames table, get frame
+    frames_table frames(get_self(), get_self().value);
+    auto& frm = frames.get(frame_name.value, "frame not found");
 
-    //apply tag overrides
-    for (auto itr = override_tags.begin(); itr != override_tags.end(); itr++) {
-        //open tags table, search for tag
-        tags_table tags(get_self(), item_serial);
-        auto tg_itr = tags.find(itr->first.value);
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(frm.group.value, "group not found");
 
-        //if tag not found
-        if (tg_itr == tags.end()) {
-            //emplace new tag
-            //ram payer: contract
-            tags.emplace(get_self(), [&](auto& col) {
-                col.tag_name = itr->first;
-                col.content = itr->second;
-                col.checksum = "";
-                col.algorithm = "";
-            });
-        } else {
-            //overwrite existing tag
-            tags.modify(tg_itr, same_payer, [&](auto& col) {
-                col.content = itr->second;
-                col.checksum = "";
-                col.algorithm = "";
-            });
-        }
+    //authenticate
+    require_auth(grp.manager);
+
+    //initialize
+    uint64_t count = recipients.size();
+
+    //migrate group
+    migrate_group(groups, grp);
+
+    //validate
+    check(grp.behavior_states.value() & MINT_FLAG, "item is not mintable");
+    check(count > 0, "must build at least one item");
+    check(count <= grp.supply_cap - grp.supply, "supply cap reached");
+
+    //validate recipients
+    for (name r : recipients) {
+        check(is_account(r), "recipient account doesn't exist");
     }
 
-    //apply attribute overrides
-    for (auto itr = override_attributes.begin(); itr != override_attributes.end(); itr++) {
-        //open attributes table, find attribute
-        attributes_table attributes(get_self(), item_serial);
-        auto attr_itr = attributes.find(itr->first.value);
+    //resolve frame defaults and overrides
+    resolve_frame(frm, override_tags, override_attributes);
 
-        //if attribute not found
-        if (attr_itr == attributes.end()) {
-            
-            //emplace new attribute
-            //ram payer: self
-            attributes.emplace(get_self(), [&](auto& col) {
-                col.attribute_name = itr->first;
-                col.points = itr->second;
-            });
-        } else {
-            //overwrite existing attribute
-            attributes.modify(attr_itr, same_payer, [&](auto& col) {
-                col.points = itr->second;
-            });
+    //initialize
+    uint64_t first_serial = reserve_serials(groups, grp, count);
+    uint64_t new_serial = first_serial;
+
+    //retain tag contents once for every built item
+    map<name, uint64_t> tag_blobs = retain_blobs(override_tags, count);
+
+    //open items table
+    items_table items(get_self(), get_self().value);
+
+    //build an item for each recipient
+    for (name r : recipients) {
+        //emplace new item
+        //ram payer: self
+        auto itm_itr = items.emplace(get_self(), [&](auto& col) {
+            col.serial = new_serial;
+            col.group = frm.group;
+            col.owner = r;
+            col.frame.emplace((frm.inherit.value_or(false)) ? frame_name : name(0));
+        });
+
+        //write tags and attributes
+        decorate_item(new_serial, grp, tag_blobs, override_attributes);
+
+        //rank inherited attributes
+        if (frm.inherit.value_or(false)) {
+            rank_defaults(frm, grp, *itm_itr);
         }
+
+        new_serial++;
     }
+
+    //emit mint event
+    emit_range(grp, "mint"_n, first_serial, count);
 }
 
 ACTION marble::cleanframe(name frame_name, uint64_t serial)
@@ -236,6 +308,21 @@ ACTION marble::cleanframe(name frame_name, uint64_t serial)
     //authenticate
     require_auth(grp.manager);
 
+    //if frame is inherited
+    if (frm.inherit.value_or(false)) {
+        //open items table, find item
+        items_table items(get_self(), get_self().value);
+        auto itm_itr = items.find(serial);
+
+        //if item linked to frame
+        if (itm_itr != items.end() && itm_itr->frame.value_or() == frame_name) {
+            //unlink item from frame
+            items.modify(itm_itr, same_payer, [&](auto& col) {
+                col.frame.emplace(name(0));
+            });
+        }
+    }
+
     //clean default tags
     for (auto itr = frm.default_tags.begin(); itr != frm.default_tags.end(); itr++) {
         //open tags table, find tag
@@ -244,6 +331,9 @@ ACTION marble::cleanframe(name frame_name, uint64_t serial)
 
         //if tag found
         if (tag_itr != tags.end()) {
+            //release content
+            release_blob(tag_itr->blob_id.value_or());
+
             //delete tag
             tags.erase(*tag_itr);
         }
@@ -251,14 +341,9 @@ ACTION marble::cleanframe(name frame_name, uint64_t serial)
 
     //clean default attributes
     for (auto itr = frm.default_attributes.begin(); itr != frm.default_attributes.end(); itr++) {
-        //open attributes table, find attribute
-        attributes_table attributes(get_self(), serial);
-        auto attr_itr = attributes.find(itr->first.value);
-
-        //if attribute found
-        if (attr_itr != attributes.end()) {
-            //delete attribute
-            attributes.erase(*attr_itr);
+        //delete attribute if found, otherwise drop inherited rank
+        if (!erase_item_attribute(serial, grp, itr->first)) {
+            sync_rank(grp, serial, itr->first, {});
         }
     }
 
@@ -289,6 +374,116 @@ ACTION marble::rmvframe(name frame_name, string memo)
     //authenticate
     require_auth(grp.manager);
 
+    //validate
+    check(!frm.inherit.value_or(false), "cannot remove an inherited frame");
+
     //erase frame
     frames.erase(frm);
 }
+
+//======================== frame functions ========================
+
+void marble::resolve_frame(const frame& frm, map<name, string>& tags, map<name, int64_t>& attributes)
+{
+    //if frame is inherited
+    if (frm.inherit.value_or(false)) {
+        //drop override tags equal to defaults
+        for (auto itr = tags.begin(); itr != tags.end();) {
+            auto def_itr = frm.default_tags.find(itr->first);
+            itr = (def_itr != frm.default_tags.end() && def_itr->second == itr->second) ? tags.erase(itr) : ++itr;
+        }
+
+        //drop override attributes equal to defaults
+        for (auto itr = attributes.begin(); itr != attributes.end();) {
+            auto def_itr = frm.default_attributes.find(itr->first);
+            itr = (def_itr != frm.default_attributes.end() && def_itr->second == itr->second) ? attributes.erase(itr) : ++itr;
+        }
+    } else {
+        //merge in defaults (existing overrides are kept)
+        tags.insert(frm.default_tags.begin(), frm.default_tags.end());
+        attributes.insert(frm.default_attributes.begin(), frm.default_attributes.end());
+    }
+}
+
+optional<string> marble::inherited_tag(const item& itm, name tag_name)
+{
+    //if item not linked to a frame
+    if (itm.frame.value_or() == name(0)) {
+        return {};
+    }
+
+    //open frames table, get frame
+    frames_table frames(get_self(), get_self().value);
+    auto& frm = frames.get(itm.frame.value_or().value, "frame not found");
+
+    //find default tag
+    auto def_itr = frm.default_tags.find(tag_name);
+
+    if (def_itr == frm.default_tags.end()) {
+        return {};
+    }
+
+    return def_itr->second;
+}
+
+optional<int64_t> marble::inherited_attribute(const item& itm, name attribute_name)
+{
+    //if item not linked to a frame
+    if (itm.frame.value_or() == name(0)) {
+        return {};
+    }
+
+    //open frames table, get frame
+    frames_table frames(get_self(), get_self().value);
+    auto& frm = frames.get(itm.frame.value_or().value, "frame not found");
+
+    //find default attribute
+    auto def_itr = frm.default_attributes.find(attribute_name);
+
+    if (def_itr == frm.default_attributes.end()) {
+        return {};
+    }
+
+    return def_itr->second;
+}
+
+void marble::decorate_item(uint64_t serial, const group& grp, const map<name, uint64_t>& tag_blobs, const map<name, int64_t>& resolved_attributes)
+{
+    //open tags table
+    tags_table tags(get_self(), serial);
+
+    //emplace tags
+    for (auto& t : tag_blobs) {
+        //emplace new tag
+        //ram payer: contract
+        tags.emplace(get_self(), [&](auto& col) {
+            col.tag_name = t.first;
+            col.content = "";
+            col.blob_id.emplace(t.second);
+            col.checksum = "";
+            col.algorithm = "";
+            col.locked = false;
+        });
+    }
+
+    //write attributes in group storage layout
+    emplace_item_attributes(serial, grp, resolved_attributes);
+}
+
+void marble::rank_defaults(const frame& frm, const group& grp, const item& itm)
+{
+    //skip groups without ranked attributes
+    if (!(grp.options.value_or() & RANKED_ATTRS_OPT)) {
+        return;
+    }
+
+    //rank default attributes at their current points
+    for (auto& a : frm.default_attributes) {
+        //get attribute
+        auto attr = get_item_attribute(itm, grp, a.first);
+
+        if (attr) {
+            sync_rank(grp, itm.serial, a.first, attr->points);
+        }
+    }
+}
@@ -19,6 +19,10 @@ ACTION marble::newtag(uint64_t serial, name tag_name, string content, optional<s
     //initialize
     string chsum = (checksum) ? *checksum : "";
     string algo = (algorithm) ? *algorithm : "";
+    checksum256 content_hash = sha256(content.data(), content.size());
+
+    //validate
+    verify_checksum(content_hash, chsum, algo);
 
     //if shared tag
     if (shared) {
@@ -45,12 +49,17 @@ ACTION marble::newtag(uint64_t serial, name tag_name, string content, optional<s
 
         //validate
         check(tag_itr == tags.end(), "tag name already exists on item");
+        check(!inherited_tag(itm, tag_name), "tag name already inherited from frame");
+
+        //initialize
+        uint64_t content_blob = retain_blob(content_hash, content, 1);
 
         //emplace tag
         //ram payer: self
         tags.emplace(get_self(), [&](auto& col) {
             col.tag_name = tag_name;
-            col.content = content;
+            col.content = "";
+            col.blob_id.emplace(content_blob);
             col.checksum = chsum;
             col.algorithm = algo;
             col.locked = false;
@@ -73,6 +82,7 @@ ACTION marble::updatetag(uint64_t serial, name tag_name, string new_content, opt
 
     string new_chsum = (new_checksum) ? *new_checksum : "";
     string new_algo = (new_algorithm) ? *new_algorithm : "";
+    checksum256 content_hash = sha256(new_content.data(), new_content.size());
 
     // if (new_checksum) {
     //     new_chsum = *new_checksum;
@@ -82,6 +92,9 @@ ACTION marble::updatetag(uint64_t serial, name tag_name, string new_content, opt
     //     new_algo = *new_algorithm;
     // }
 
+    //validate
+    verify_checksum(content_hash, new_chsum, new_algo);
+
     //if shared tag
     if (shared) {
         //open shared tags table, get shared tag
@@ -98,19 +111,47 @@ ACTION marble::updatetag(uint64_t serial, name tag_name, string new_content, opt
             col.algorithm = new_algo;
         });
     } else {
-        //open tags table, get tag
+        //open tags table, find tag
         tags_table tags(get_self(), serial);
-        auto& t = tags.get(tag_name.value, "tag not found on item");
-
-        //validate
-        check(!t.locked, "tag is locked");
+        auto tag_itr = tags.find(tag_name.value);
 
-        //update tag
-        tags.modify(t, same_payer, [&](auto& col) {
-            col.content = new_content;
-            col.checksum = new_chsum;
-            col.algorithm = new_algo;
-        });
+        //if tag not found
+        if (tag_itr == tags.end()) {
+            //validate
+            check(inherited_tag(itm, tag_name).has_value(), "tag not found on item");
+
+            //initialize
+            uint64_t content_blob = retain_blob(content_hash, new_content, 1);
+
+            //emplace overriding tag
+            //ram payer: self
+            tags.emplace(get_self(), [&](auto& col) {
+                col.tag_name = tag_name;
+                col.content = "";
+                col.blob_id.emplace(content_blob);
+                col.checksum = new_chsum;
+                col.algorithm = new_algo;
+                col.locked = false;
+            });
+        } else {
+            //validate
+            check(!tag_itr->locked, "tag is locked");
+
+            //initialize
+            uint64_t old_blob = tag_itr->blob_id.value_or();
+            uint64_t content_blob = retain_blob(content_hash, new_content, 1);
+
+            //release old content
+            release_blob(old_blob);
+
+            //update tag
+            tags.modify(tag_itr, same_payer, [&](auto& col) {
+                col.content = "";
+                col.blob_id.emplace(content_blob);
+                col.checksum = new_chsum;
+                col.algorithm = new_algo;
+            });
+        }
     }
 }
 
@@ -141,17 +182,40 @@ ACTION marble::locktag(uint64_t serial, name tag_name, bool shared)
             col.locked = true;
         });
     } else {
-        //open tags table, get tag
+        //open tags table, find tag
         tags_table tags(get_self(), serial);
-        auto& t = tags.get(tag_name.value, "tag not found on item");
-
-        //validate
-        check(!t.locked, "tag is already locked");
+        auto tag_itr = tags.find(tag_name.value);
 
-        //modify tag
-        tags.modify(t, same_payer, [&](auto& col) {
-            col.locked = true;
-        });
+        //if tag not found
+        if (tag_itr == tags.end()) {
+            //get inherited tag
+            auto inh_content = inherited_tag(itm, tag_name);
+
+            //validate
+            check(inh_content.has_value(), "tag not found on item");
+
+            //initialize
+            uint64_t content_blob = retain_blob(sha256(inh_content->data(), inh_content->size()), *inh_content, 1);
+
+            //emplace locked copy of inherited tag
+            //ram payer: self
+            tags.emplace(get_self(), [&](auto& col) {
+                col.tag_name = tag_name;
+                col.content = "";
+                col.blob_id.emplace(content_blob);
+                col.checksum = "";
+                col.algorithm = "";
+                col.locked = true;
+            });
+        } else {
+            //validate
+            check(!tag_itr->locked, "tag is already locked");
+
+            //modify tag
+            tags.modify(tag_itr, same_payer, [&](auto& col) {
+                col.locked = true;
+            });
+        }
     }
 }
 
@@ -177,7 +241,303 @@ ACTION marble::rmvtag(uint64_t serial, name group_name, name tag_name, string me
         tags_table tags(get_self(), serial);
         auto& t = tags.get(tag_name.value, "tag not found on item");
 
+        //release content
+        release_blob(t.blob_id.value_or());
+
         //remove item
         tags.erase(t);
     }
 }
+
+ACTION marble::settags(uint64_t serial, vector<tag_op> ops, bool shared)
+{
+    //open items table, get item
+    items_table items(get_self(), get_self().value);
+    auto& itm = items.get(serial, "item not found");
+
+    //open groups table, get group
+    groups_table groups(get_self(), get_self().value);
+    auto& grp = groups.get(itm.group.value, "group not found");
+
+    //authenticate
+    require_auth(grp.manager);
+
+    //validate
+    check(ops.size() > 0, "must apply at least one tag op");
+
+    //if shared tags
+    if (shared) {
+        //open shared tags table
+        shared_tags_table shared_tags(get_self(), grp.group_name.value);
+
+        for (auto& o : ops) {
+            //find shared tag
+            auto shared_tag_itr = shared_tags.find(o.tag_name.value);
+
+            switch (o.op.value) {
+                case name("create").value:
+                    //validate
+                    check(o.tag_name != name(0), "tag name cannot be empty");
+                    check(shared_tag_itr == shared_tags.end(), "shared tag name already exists");
+                    verify_checksum(sha256(o.content.data(), o.content.size()), o.checksum.value_or(""), o.algorithm.value_or(""));
+
+                    //emplace shared tag
+                    //ram payer: self
+                    shared_tags.emplace(get_self(), [&](auto& col) {
+                        col.tag_name = o.tag_name;
+                        col.content = o.content;
+                        col.checksum = o.checksum.value_or("");
+                        col.algorithm = o.algorithm.value_or("");
+                        col.locked = false;
+                    });
+                    break;
+                case name("update").value:
+                    //validate
+                    check(shared_tag_itr != shared_tags.end(), "shared tag not found");
+                    check(!shared_tag_itr->locked, "shared tag is locked");
+                    verify_checksum(sha256(o.content.data(), o.content.size()), o.checksum.value_or(""), o.algorithm.value_or(""));
+
+                    //update shared tag
+                    shared_tags.modify(shared_tag_itr, same_payer, [&](auto& col) {
+                        col.content = o.content;
+                        col.checksum = o.checksum.value_or("");
+                        col.algorithm = o.algorithm.value_or("");
+                    });
+                    break;
+                case name("lock").value:
+                    //validate
+                    check(shared_tag_itr != shared_tags.end(), "shared tag not found");
+                    check(!shared_tag_itr->locked, "shared tag is already locked");
+
+                    //modify shared tag
+                    shared_tags.modify(shared_tag_itr, same_payer, [&](auto& col) {
+                        col.locked = true;
+                    });
+                    break;
+                case name("remove").value:
+                    //validate
+                    check(shared_tag_itr != shared_tags.end(), "shared tag not found");
+
+                    //remove shared tag
+                    shared_tags.erase(shared_tag_itr);
+                    break;
+                default:
+                    check(false, "invalid tag op");
+            }
+        }
+    } else {
+        //open tags table
+        tags_table tags(get_self(), serial);
+
+        for (auto& o : ops) {
+            //find tag
+            auto tag_itr = tags.find(o.tag_name.value);
+
+            switch (o.op.value) {
+                case name("create").value: {
+                    //validate
+                    check(o.tag_name != name(0), "tag name cannot be empty");
+                    check(tag_itr == tags.end(), "tag name already exists on item");
+                    check(!inherited_tag(itm, o.tag_name), "tag name already inherited from frame");
+
+                    //initialize
+                    checksum256 content_hash = sha256(o.content.data(), o.content.size());
+                    verify_checksum(content_hash, o.checksum.value_or(""), o.algorithm.value_or(""));
+                    uint64_t content_blob = retain_blob(content_hash, o.content, 1);
+
+                    //emplace tag
+                    //ram payer: self
+                    tags.emplace(get_self(), [&](auto& col) {
+                        col.tag_name = o.tag_name;
+                        col.content = "";
+                        col.blob_id.emplace(content_blob);
+                        col.checksum = o.checksum.value_or("");
+                        col.algorithm = o.algorithm.value_or("");
+                        col.locked = false;
+                    });
+                    break;
+                }
+                case name("update").value: {
+                    //validate
+                    check(tag_itr != tags.end() || inherited_tag(itm, o.tag_name).has_value(), "tag not found on item");
+
+                    //initialize
+                    checksum256 content_hash = sha256(o.content.data(), o.content.size());
+                    verify_checksum(content_hash, o.checksum.value_or(""), o.algorithm.value_or(""));
+
+                    //if tag not found
+                    if (tag_itr == tags.end()) {
+                        //initialize
+                        uint64_t content_blob = retain_blob(content_hash, o.content, 1);
+
+                        //emplace overriding tag
+                        //ram payer: self
+                        tags.emplace(get_self(), [&](auto& col) {
+                            col.tag_name = o.tag_name;
+                            col.content = "";
+                            col.blob_id.emplace(content_blob);
+                            col.checksum = o.checksum.value_or("");
+                            col.algorithm = o.algorithm.value_or("");
+                            col.locked = false;
+                        });
+                    } else {
+                        //validate
+                        check(!tag_itr->locked, "tag is locked");
+
+                        //initialize
+                        uint64_t old_blob = tag_itr->blob_id.value_or();
+                        uint64_t content_blob = retain_blob(content_hash, o.content, 1);
+
+                        //release old content
+                        release_blob(old_blob);
+
+                        //update tag
+                        tags.modify(tag_itr, same_payer, [&](auto& col) {
+                            col.content = "";
+                            col.blob_id.emplace(content_blob);
+                            col.checksum = o.checksum.value_or("");
+                            col.algorithm = o.algorithm.value_or("");
+                        });
+                    }
+                    break;
+                }
+                case name("lock").value: {
+                    //if tag not found
+                    if (tag_itr == tags.end()) {
+                        //get inherited tag
+                        auto inh_content = inherited_tag(itm, o.tag_name);
+
+                        //validate
+                        check(inh_content.has_value(), "tag not found on item");
+
+                        //initialize
+                        uint64_t content_blob = retain_blob(sha256(inh_content->data(), inh_content->size()), *inh_content, 1);
+
+                        //emplace locked copy of inherited tag
+                        //ram payer: self
+                        tags.emplace(get_self(), [&](auto& col) {
+                            col.tag_name = o.tag_name;
+                            col.content = "";
+                            col.blob_id.emplace(content_blob);
+                            col.checksum = "";
+                            col.algorithm = "";
+                            col.locked = true;
+                        });
+                    } else {
+                        //validate
+                        check(!tag_itr->locked, "tag is already locked");
+
+                        //modify tag
+                        tags.modify(tag_itr, same_payer, [&](auto& col) {
+                            col.locked = true;
+                        });
+                    }
+                    break;
+                }
+                case name("remove").value:
+                    //validate
+                    check(tag_itr != tags.end(), "tag not found on item");
+
+                    //release content
+                    release_blob(tag_itr->blob_id.value_or());
+
+                    //remove tag
+                    tags.erase(tag_itr);
+                    break;
+                default:
+                    check(false, "invalid tag op");
+            }
+        }
+    }
+}
+
+//======================== tag functions ========================
+
+void marble::verify_checksum(const checksum256& content_hash, const string& checksum, const string& algorithm)
+{
+    //skip unverified algorithms, checksums of other algorithms may cover off-chain content
+    if (algorithm != "sha256-content") {
+        return;
+    }
+
+    //encode hash as lowercase hex
+    const char* hex_chars = "0123456789abcdef";
+    auto hash_bytes = content_hash.extract_as_byte_array();
+    string hash_hex(hash_bytes.size() * 2, '0');
+    for (size_t i = 0; i < hash_bytes.size(); i++) {
+        hash_hex[i * 2] = hex_chars[hash_bytes[i] >> 4];
+        hash_hex[i * 2 + 1] = hex_chars[hash_bytes[i] & 0x0f];
+    }
+
+    //validate
+    check(checksum == hash_hex, "checksum does not match content");
+}
+
+uint64_t marble::retain_blob(const checksum256& content_hash, const string& content, uint64_t refs)
+{
+    //open blobs table, get by hash index, find blob
+    blobs_table blobs(get_self(), get_self().value);
+    auto blobs_by_hash = blobs.get_index<"byhash"_n>();
+    auto blob_itr = blobs_by_hash.find(content_hash);
+
+    //if blob found
+    if (blob_itr != blobs_by_hash.end()) {
+        //add references
+        blobs_by_hash.modify(blob_itr, same_payer, [&](auto& col) {
+            col.refs += refs;
+        });
+
+        return blob_itr->blob_id;
+    }
+
+    //initialize
+    uint64_t new_blob_id = std::max<uint64_t>(blobs.available_primary_key(), 1);
+
+    //emplace new blob
+    //ram payer: contract
+    blobs.emplace(get_self(), [&](auto& col) {
+        col.blob_id = new_blob_id;
+        col.content_hash = content_hash;
+        col.content = content;
+        col.refs = refs;
+    });
+
+    return new_blob_id;
+}
+
+map<name, uint64_t> marble::retain_blobs(const map<name, string>& tags, uint64_t refs)
+{
+    //initialize
+    map<name, uint64_t> tag_blobs;
+
+    //hash each content once for all referencing items
+    for (auto& t : tags) {
+        tag_blobs[t.first] = retain_blob(sha256(t.second.data(), t.second.size()), t.second, refs);
+    }
+
+    return tag_blobs;
+}
+
+void marble::release_blob(uint64_t blob_id)
+{
+    //if inline content
+    if (blob_id == 0) {
+        return;
+    }
+
+    //open blobs table, get blob
+    blobs_table blobs(get_self(), get_self().value);
+    auto& b = blobs.get(blob_id, "blob not found");
+
+    //if last reference
+    if (b.refs <= 1) {
+        //erase blob
+        blobs.erase(b);
+    } else {
+        //remove reference
+        blobs.modify(b, same_payer, [&](auto& col) {
+            col.refs -= 1;
+        });
+    }
+}
+
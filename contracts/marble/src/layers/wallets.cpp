@@ -1,70 +1,386 @@
 //======================== wallet actions ========================
 
-ACTION marble::withdraw(name wallet_owner, asset amount)
+ACTION marble::newcurrency(symbol currency_sym, name home_contract)
 {
+    //open config table, get config
+    config_table configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //authenticate
+    require_auth(conf.admin);
+
+    //open currencies table, search for currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto curr_itr = currencies.find(currency_sym.code().raw());
+
     //validate
-    check(amount.symbol == CORE_SYM, "can only withdraw core token");
-    
+    check(currency_sym.is_valid(), "invalid currency symbol");
+    check(curr_itr == currencies.end(), "currency already exists");
+    check(is_account(home_contract), "home contract account doesn't exist");
+    check(home_contract != get_self(), "home contract cannot be self");
+
+    //emplace new currency
+    //ram payer: contract
+    currencies.emplace(get_self(), [&](auto& col) {
+        col.total_deposits = asset(0, currency_sym);
+        col.total_wallets = 0;
+        col.home_contract = home_contract;
+        col.approved = true;
+        col.total_bonds.emplace(0);
+    });
+}
+
+ACTION marble::setcurrency(symbol_code currency_code, bool approved)
+{
+    //open config table, get config
+    config_table configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //authenticate
+    require_auth(conf.admin);
+
+    //open currencies table, get currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto& curr = currencies.get(currency_code.raw(), "currency not found");
+
+    //validate
+    check(curr.approved != approved, "currency approval is already set to this value");
+
+    //update currency
+    currencies.modify(curr, same_payer, [&](auto& col) {
+        col.approved = approved;
+    });
+}
+
+ACTION marble::synccurrency(asset total_deposits, uint32_t total_wallets, uint32_t total_bonds, name home_contract)
+{
+    //open config table, get config
+    config_table configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //authenticate
+    require_auth(conf.admin);
+
+    //validate
+    check(total_deposits.is_valid(), "invalid total deposits");
+    check(total_deposits.amount >= 0, "total deposits cannot be negative");
+
+    //open currencies table, search for currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto curr_itr = currencies.find(total_deposits.symbol.code().raw());
+
+    //if currency not found
+    if (curr_itr == currencies.end()) {
+        //validate
+        check(is_account(home_contract), "home contract account doesn't exist");
+        check(home_contract != get_self(), "home contract cannot be self");
+
+        //register currency with counted totals
+        //ram payer: contract
+        currencies.emplace(get_self(), [&](auto& col) {
+            col.total_deposits = total_deposits;
+            col.total_wallets = total_wallets;
+            col.home_contract = home_contract;
+            col.approved = true;
+            col.total_bonds.emplace(total_bonds);
+        });
+    } else {
+        //validate
+        check(total_deposits.symbol == curr_itr->total_deposits.symbol, "symbol precision mismatch");
+        check(home_contract == curr_itr->home_contract, "home contract mismatch");
+
+        //update currency totals
+        currencies.modify(curr_itr, same_payer, [&](auto& col) {
+            col.total_deposits = total_deposits;
+            col.total_wallets = total_wallets;
+            col.total_bonds.emplace(total_bonds);
+        });
+    }
+}
+
+ACTION marble::rmvcurrency(symbol_code currency_code)
+{
+    //open config table, get config
+    config_table configs(get_self(), get_self().value);
+    auto conf = configs.get();
+
+    //authenticate
+    require_auth(conf.admin);
+
+    //open currencies table, get currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto& curr = currencies.get(currency_code.raw(), "currency not found");
+
+    //validate
+    check(curr.total_deposits.amount == 0, "cannot remove currency with deposits");
+    check(curr.total_wallets == 0, "cannot remove currency held in wallets");
+    check(curr.total_bonds.value_or() == 0, "cannot remove currency backing bonds");
+
+    //erase currency
+    currencies.erase(curr);
+}
+
+ACTION marble::withdraw(name wallet_owner, asset amount)
+{
     //authenticate
     require_auth(wallet_owner);
 
-    //open wallets table, get deposit
+    //open currencies table, get currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto& curr = currencies.get(amount.symbol.code().raw(), "currency not found");
+
+    //validate
+    check(amount.amount > 0, "must withdraw a positive amount");
+    check(curr.total_deposits >= amount, "currency deposits out of sync with wallets");
+
+    //initialize
+    name home_contract = curr.home_contract;
+
+    //update currency deposits
+    currencies.modify(curr, same_payer, [&](auto& col) {
+        col.total_deposits -= amount;
+    });
+
+    //subtract from wallet balance
+    debit_wallet(wallet_owner, amount);
+
+    //send inline transfer to withdrawing account from currency home contract
+    //auth: self
+    action(permission_level{get_self(), name("active")}, home_contract, name("transfer"), make_tuple(
+        get_self(), //from
+        wallet_owner, //to
+        amount, //quantity
+        std::string("Marble Wallet Withdrawal") //memo
+    )).send();
+}
+
+ACTION marble::payout(name from, vector<pair<name, asset>> payments)
+{
+    //authenticate
+    require_auth(from);
+
+    //validate
+    check(payments.size() > 0, "must pay at least one recipient");
+
+    //initialize
+    map<symbol_code, asset> debits; //currency => total paid
+    map<name, map<symbol_code, asset>> credits; //recipient => currency => total received
+
+    //loop over payments
+    for (auto& p : payments) {
+        //validate
+        check(p.first != from, "cannot pay self");
+        check(p.second.amount > 0, "must pay a positive amount");
+
+        //if recipient not seen yet
+        if (credits.find(p.first) == credits.end()) {
+            //validate
+            check(is_account(p.first), "recipient account doesn't exist");
+        }
+
+        //add to payer debit
+        auto deb_itr = debits.find(p.second.symbol.code());
+        if (deb_itr == debits.end()) {
+            debits.emplace(p.second.symbol.code(), p.second);
+        } else {
+            deb_itr->second += p.second;
+        }
+
+        //add to recipient credit
+        auto& recipient_credits = credits[p.first];
+        auto cred_itr = recipient_credits.find(p.second.symbol.code());
+        if (cred_itr == recipient_credits.end()) {
+            recipient_credits.emplace(p.second.symbol.code(), p.second);
+        } else {
+            cred_itr->second += p.second;
+        }
+    }
+
+    //debit payer wallet once per currency
+    for (auto& d : debits) {
+        debit_wallet(from, d.second);
+    }
+
+    //credit recipient wallets once per currency
+    for (auto& c : credits) {
+        credit_wallets(c.first, c.second);
+    }
+}
+
+//======================== wallet functions ========================
+
+void marble::credit_wallet(name wallet_owner, asset amount)
+{
+    //open wallets table, search for wallet
+    wallets_table wallets(get_self(), wallet_owner.value);
+    auto wall_itr = wallets.find(amount.symbol.code().raw());
+
+    //if wallet found
+    if (wall_itr != wallets.end()) {
+        //add to existing wallet
+        wallets.modify(*wall_itr, same_payer, [&](auto& col) {
+            col.balance += amount;
+        });
+    } else {
+        //create new wallet
+        //ram payer: contract
+        wallets.emplace(get_self(), [&](auto& col) {
+            col.balance = amount;
+        });
+
+        //open currencies table, get currency
+        currencies_table currencies(get_self(), get_self().value);
+        auto& curr = currencies.get(amount.symbol.code().raw(), "currency not found");
+
+        //update currency wallet count
+        currencies.modify(curr, same_payer, [&](auto& col) {
+            col.total_wallets += 1;
+        });
+    }
+}
+
+void marble::credit_wallets(name wallet_owner, const map<symbol_code, asset>& amounts)
+{
+    //credit wallet once per currency
+    for (auto& a : amounts) {
+        credit_wallet(wallet_owner, a.second);
+    }
+}
+
+void marble::debit_wallet(name wallet_owner, asset amount)
+{
+    //open wallets table, get wallet
     wallets_table wallets(get_self(), wallet_owner.value);
     auto& wall = wallets.get(amount.symbol.code().raw(), "wallet not found");
 
     //validate
-    check(amount.amount > 0, "must withdraw a positive amount");
     check(wall.balance >= amount, "insufficient funds");
 
-    //if withdrawing all tokens
+    //if wallet emptied
     if (wall.balance == amount) {
         //erase wallet
         wallets.erase(wall);
+
+        //open currencies table, get currency
+        currencies_table currencies(get_self(), get_self().value);
+        auto& curr = currencies.get(amount.symbol.code().raw(), "currency not found");
+
+        //validate
+        check(curr.total_wallets > 0, "currency wallets out of sync");
+
+        //update currency wallet count
+        currencies.modify(curr, same_payer, [&](auto& col) {
+            col.total_wallets -= 1;
+        });
     } else {
         //update wallet balance
         wallets.modify(wall, same_payer, [&](auto& col) {
             col.balance -= amount;
         });
     }
+}
 
-    //send inline eosio.token::transfer to withdrawing account
-    //auth: self
-    action(permission_level{get_self(), name("active")}, name("eosio.token"), name("transfer"), make_tuple(
-        get_self(), //from
-        wallet_owner, //to
-        amount, //quantity
-        std::string("Marble Wallet Withdrawal") //memo
-    )).send();
+void marble::count_bonds(symbol_code currency_code, int64_t delta)
+{
+    //open currencies table, get currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto& curr = currencies.get(currency_code.raw(), "currency not found");
+
+    //validate
+    check(int64_t(curr.total_bonds.value_or()) + delta >= 0, "currency bonds out of sync");
+
+    //update currency bond count
+    currencies.modify(curr, same_payer, [&](auto& col) {
+        col.total_bonds.emplace(uint32_t(int64_t(col.total_bonds.value_or()) + delta));
+    });
+}
+
+uint64_t marble::parse_serial(string_view digits)
+{
+    //validate
+    check(digits.size() > 0 && digits.size() <= 20, "malformed serial in memo");
+
+    //initialize
+    uint64_t serial = 0;
+
+    //parse digits
+    for (char c : digits) {
+        //validate
+        check(c >= '0' && c <= '9', "malformed serial in memo");
+        check(serial <= (UINT64_MAX - (c - '0')) / 10, "serial in memo out of range");
+
+        serial = serial * 10 + (c - '0');
+    }
+
+    return serial;
 }
 
 //======================== notification handlers ========================
 
 void marble::catch_transfer(name from, name to, asset quantity, string memo)
 {
-    //get initial receiver contract
-    name rec = get_first_receiver();
-
-    //if received notification from eosio.token, not from self, and symbol is CORE SYM
-    if (rec == name("eosio.token") && from != get_self() && quantity.symbol == CORE_SYM) {
-        //if memo is "deposit"
-        if (memo == std::string("deposit")) { 
-            //open wallets table, search for wallet
-            wallets_table wallets(get_self(), from.value);
-            auto wall_itr = wallets.find(CORE_SYM.code().raw());
-
-            //if wallet found
-            if (wall_itr != wallets.end()) {
-                //add to existing wallet
-                wallets.modify(*wall_itr, same_payer, [&](auto& col) {
-                    col.balance += quantity;
-                });
-            } else {
-                //create new wallet
-                //ram payer: contract
-                wallets.emplace(get_self(), [&](auto& col) {
-                    col.balance = quantity;
-                });
-            }
+    //initialize
+    string_view route = memo;
+
+    //if not a deposit to self or memo not routed
+    if (from == get_self() || to != get_self() ||
+        (route != "deposit" && route.substr(0, 5) != "bond:" && route.substr(0, 10) != "bondrange:")) {
+        return;
+    }
+
+    //open currencies table, find currency
+    currencies_table currencies(get_self(), get_self().value);
+    auto curr_itr = currencies.find(quantity.symbol.code().raw());
+
+    //validate
+    check(curr_itr != currencies.end(), "currency not registered");
+
+    //if notification not from currency home contract
+    if (curr_itr->home_contract != get_first_receiver()) {
+        return;
+    }
+
+    //validate
+    check(curr_itr->approved, "currency deposits are not approved");
+    check(quantity.symbol == curr_itr->total_deposits.symbol, "symbol precision mismatch");
+
+    //update currency deposits
+    currencies.modify(curr_itr, same_payer, [&](auto& col) {
+        col.total_deposits += quantity;
+    });
+
+    //if memo is "deposit"
+    if (route == "deposit") {
+        //add to sender wallet
+        credit_wallet(from, quantity);
+    } else if (route.substr(0, 5) == "bond:") {
+        //fund item bond
+        fund_bond(parse_serial(route.substr(5)), quantity, from);
+    } else {
+        //initialize
+        string_view range = route.substr(10);
+        size_t sep = range.find(':');
+
+        //validate
+        check(sep != string_view::npos, "malformed bondrange memo");
+
+        //initialize
+        uint64_t first_serial = parse_serial(range.substr(0, sep));
+        uint64_t last_serial = parse_serial(range.substr(sep + 1));
+
+        //validate
+        check(first_serial <= last_serial, "malformed bondrange memo");
+        check(last_serial - first_serial < 1000, "bondrange cannot exceed 1000 serials");
+
+        //initialize
+        int64_t count = last_serial - first_serial + 1;
+
+        //validate
+        check(quantity.amount % count == 0, "quantity must divide evenly across bondrange");
+
+        //fund each item bond
+        for (uint64_t s = first_serial; s <= last_serial; s++) {
+            fund_bond(s, asset(quantity.amount / count, quantity.symbol), from);
         }
     }
 }
\ No newline at end of file
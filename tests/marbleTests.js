@@ -1,11 +1,15 @@
 //eoslime
 const eoslime = require("eoslime").init("local");
 const assert = require('assert');
+const crypto = require('crypto');
 
 //contracts
 const MARBLE_WASM = "./build/marble/marble.wasm";
 const MARBLE_ABI = "./build/marble/marble.abi";
 
+//local chain
+const EOSIO_PRIVATE_KEY = "5KQwrPbwdL6PhXujxW37FSSQZ1JiwsST4cqQzDeyXtP79zkvFD3";
+
 describe("Marble Digital Items Tests", function () {
     //increase mocha testing timeframe
     this.timeout(15000);
@@ -45,7 +49,15 @@ describe("Marble Digital Items Tests", function () {
         assert(confTable[0].contract_name == contractName, "Incorrect Contract Name");
         assert(confTable[0].contract_version == contractVersion, "Incorrect Contract Version");
         assert(confTable[0].admin == marbleAccount.name, "Incorrect Admin");
-        // assert(confTable[0].last_serial == 0, "Incorrect Last Serial");
+
+        //assert serials table values
+        const serialsTable = await marbleContract.provider.select('serials').from('mbl').find();
+        assert(serialsTable[0].last_serial == 0, "Incorrect Last Serial");
+
+        //assert currencies table values
+        const currenciesTable = await marbleContract.provider.select('currencies').from('mbl').find();
+        assert(currenciesTable[0].total_deposits == "0.0000 TLOS", "Incorrect Core Currency");
+        assert(currenciesTable[0].home_contract == "eosio.token", "Incorrect Core Home Contract");
     });
 
     //======================== config tests ========================
@@ -97,31 +109,10 @@ describe("Marble Digital Items Tests", function () {
         assert(groupsTable[0].issued_supply == 0, "Incorrect Issued Supply");
         assert(groupsTable[0].supply_cap == groupSupplyCap, "Incorrect Supply Cap");
 
-        //assert behavior table values
-        const behaviorsTable = await marbleContract.provider.select('behaviors').from('mbl').scope('heroes').limit(10).find();
-        assert(behaviorsTable[0].behavior_name == "activate", "Incorrect Behavior Name");
-        assert(behaviorsTable[0].state == false, "Incorrect Behavior State");
-        assert(behaviorsTable[0].locked == false, "Incorrect Behavior Lock State");
-
-        assert(behaviorsTable[1].behavior_name == "consume", "Incorrect Behavior Name");
-        assert(behaviorsTable[1].state == false, "Incorrect Behavior State");
-        assert(behaviorsTable[1].locked == false, "Incorrect Behavior Lock State");
-
-        assert(behaviorsTable[2].behavior_name == "destroy", "Incorrect Behavior Name");
-        assert(behaviorsTable[2].state == true, "Incorrect Behavior State");
-        assert(behaviorsTable[2].locked == false, "Incorrect Behavior Lock State");
-
-        assert(behaviorsTable[3].behavior_name == "mint", "Incorrect Behavior Name");
-        assert(behaviorsTable[3].state == true, "Incorrect Behavior State");
-        assert(behaviorsTable[3].locked == false, "Incorrect Behavior Lock State");
-
-        assert(behaviorsTable[4].behavior_name == "reclaim", "Incorrect Behavior Name");
-        assert(behaviorsTable[4].state == false, "Incorrect Behavior State");
-        assert(behaviorsTable[4].locked == false, "Incorrect Behavior Lock State");
-
-        assert(behaviorsTable[5].behavior_name == "transfer", "Incorrect Behavior Name");
-        assert(behaviorsTable[5].state == true, "Incorrect Behavior State");
-        assert(behaviorsTable[5].locked == false, "Incorrect Behavior Lock State");
+        //assert core behavior flags (mint, transfer, destroy on)
+        assert(groupsTable[0].behavior_states == 35, "Incorrect Behavior States");
+        assert(groupsTable[0].behavior_locks == 0, "Incorrect Behavior Locks");
+        assert(groupsTable[0].options == 0, "Incorrect Group Options");
     });
 
     it("Edit Group Details", async () => {
@@ -240,6 +231,12 @@ describe("Marble Digital Items Tests", function () {
         const groupsTable = await marbleContract.provider.select('groups').from('mbl').find('heroes');
         assert(groupsTable[0].supply == 1, "Incorrect Supply");
         assert(groupsTable[0].issued_supply == 1, "Incorrect Issued Supply");
+        assert(groupsTable[0].next_serial == 2, "Incorrect Next Serial");
+        assert(groupsTable[0].serials_left == 9999, "Incorrect Serials Left");
+
+        //assert serials table values
+        const serialsTable = await marbleContract.provider.select('serials').from('mbl').find();
+        assert(serialsTable[0].last_serial == 10000, "Incorrect Last Reserved Serial");
     });
 
     it("Transfer Single Item", async () => {
@@ -390,7 +387,8 @@ describe("Marble Digital Items Tests", function () {
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
         assert(tagsTable[0].tag_name == tagName, "Incorrect Tag Name");
-        assert(tagsTable[0].content == tagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
         assert(tagsTable[0].checksum == tagChecksum, "Incorrect Tag Checksum");
         assert(tagsTable[0].algorithm == tagAlgo, "Incorrect Tag Algorithm");
         assert(tagsTable[0].locked == false, "Incorrect Tag Locked State");
@@ -411,7 +409,8 @@ describe("Marble Digital Items Tests", function () {
 
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
-        assert(tagsTable[0].content == newTagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == newTagContent, "Incorrect Tag Content");
     });
 
     it("Lock Tag", async () => {
@@ -887,7 +886,8 @@ describe("Marble Digital Items Tests", function () {
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
         assert(tagsTable[0].tag_name == tagName, "Incorrect Tag Name");
-        assert(tagsTable[0].content == tagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
         assert(tagsTable[0].checksum == "", "Incorrect Tag Checksum");
         assert(tagsTable[0].algorithm == "", "Incorrect Tag Algorithm");
         assert(tagsTable[0].locked == false, "Incorrect Tag Locked State");
@@ -916,7 +916,8 @@ describe("Marble Digital Items Tests", function () {
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
         assert(tagsTable[0].tag_name == tagName, "Incorrect Tag Name");
-        assert(tagsTable[0].content == tagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
         assert(tagsTable[0].checksum == "", "Incorrect Tag Checksum");
         assert(tagsTable[0].algorithm == "", "Incorrect Tag Algorithm");
         assert(tagsTable[0].locked == false, "Incorrect Tag Locked State");
@@ -963,7 +964,8 @@ describe("Marble Digital Items Tests", function () {
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
         assert(tagsTable[0].tag_name == tagName, "Incorrect Tag Name");
-        assert(tagsTable[0].content == tagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
         assert(tagsTable[0].checksum == "", "Incorrect Tag Checksum");
         assert(tagsTable[0].algorithm == "", "Incorrect Tag Alogorithm");
         assert(tagsTable[0].locked == false, "Incorrect Tag Lock State");
@@ -1010,7 +1012,8 @@ describe("Marble Digital Items Tests", function () {
         //assert tags table values
         const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
         assert(tagsTable[0].tag_name == tagName, "Incorrect Tag Name");
-        assert(tagsTable[0].content == tagContent, "Incorrect Tag Content");
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
         assert(tagsTable[0].checksum == "", "Incorrect Tag Checksum");
         assert(tagsTable[0].algorithm == "", "Incorrect Tag Alogorithm");
         assert(tagsTable[0].locked == false, "Incorrect Tag Lock State");
@@ -1067,4 +1070,660 @@ describe("Marble Digital Items Tests", function () {
 
     // });
 
+    //======================== batch item tests ========================
+
+    it("Mint Multiple Items", async () => {
+        //initialize
+        const toAccount = testAccount1.name;
+        const groupName = "heroes";
+        const count = 10;
+        const firstSerial = 6;
+        const lastSerial = 15;
+
+        //call mintitems() on marble contract
+        const res = await marbleContract.actions.mintitems([toAccount, groupName, count], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "mintitems() action was not executed");
+
+        //assert items table values
+        const itemsTable = await marbleContract.provider.select('items').from('mbl').range(firstSerial, lastSerial).limit(count).find();
+        assert(itemsTable.length == count, "Incorrect Item Count");
+        assert(itemsTable[0].serial == firstSerial, "Incorrect First Serial");
+        assert(itemsTable[count - 1].serial == lastSerial, "Incorrect Last Serial");
+        assert(itemsTable[count - 1].group == groupName, "Incorrect Item Group");
+        assert(itemsTable[count - 1].owner == toAccount, "Incorrect Item Owner");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].supply == 13, "Incorrect Supply");
+        assert(groupsTable[0].issued_supply == 15, "Incorrect Issued Supply");
+
+        //assert one summary event emitted for batch
+        const traces = res.processed.action_traces[0].inline_traces;
+        assert(traces.length == 1 && traces[0].act.name == "logrange", "Batch Summary Event Not Emitted");
+    });
+
+    it("Get Inventory by Group", async () => {
+        //initialize
+        const owner = testAccount1.name;
+        const groupName = "heroes";
+        const limit = 5;
+
+        //call getinventory() on marble contract
+        const res = await marbleContract.actions.getinventory([owner, groupName, "", 0, limit], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "getinventory() action was not executed");
+
+        //assert returned page
+        const page = res.processed.action_traces[0].return_value_data;
+        assert(page.items.map(i => Number(i.serial)).join() == "3,4,5,6,7", "Incorrect Inventory Serials");
+        assert(page.items.every(i => i.group == groupName), "Incorrect Inventory Group");
+        assert(page.next_group == groupName, "Incorrect Next Group");
+        assert(page.next_cursor == 7, "Incorrect Next Cursor");
+
+        //call getinventory() on marble contract, resume from cursor
+        const res2 = await marbleContract.actions.getinventory([owner, groupName, page.next_group, page.next_cursor, limit], {from: testAccount1});
+
+        //assert returned page
+        const page2 = res2.processed.action_traces[0].return_value_data;
+        assert(page2.items.map(i => Number(i.serial)).join() == "8,9,10,11,12", "Incorrect Inventory Serials");
+        assert(page2.next_cursor == 12, "Incorrect Next Cursor");
+    });
+
+    it("Consume Multiple Items", async () => {
+        //initialize
+        const owner = testAccount1.name;
+        const serials = [6, 7];
+        const groupName = "heroes";
+
+        //call consumeitems() on marble contract
+        const res = await marbleContract.actions.consumeitems([owner, serials], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "consumeitems() action was not executed");
+
+        //assert items table values
+        const itemsTable = await marbleContract.provider.select('items').from('mbl').range(6, 7).limit(2).find();
+        assert(itemsTable.length == 0, "Items Not Consumed");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].supply == 11, "Incorrect Supply");
+        assert(groupsTable[0].issued_supply == 15, "Incorrect Issued Supply");
+    });
+
+    it("Destroy Multiple Items", async () => {
+        //initialize
+        const serials = [8, 9];
+        const memo = "";
+        const groupName = "heroes";
+
+        //call destroyitems() on marble contract
+        const res = await marbleContract.actions.destroyitems([serials, memo], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "destroyitems() action was not executed");
+
+        //assert items table values
+        const itemsTable = await marbleContract.provider.select('items').from('mbl').range(8, 9).limit(2).find();
+        assert(itemsTable.length == 0, "Items Not Destroyed");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].supply == 9, "Incorrect Supply");
+        assert(groupsTable[0].issued_supply == 15, "Incorrect Issued Supply");
+    });
+
+    it("Purge Destroyed Item", async () => {
+        //initialize
+        const serial = 4;
+        const memo = "";
+
+        //call destroyitem() on marble contract
+        await marbleContract.actions.destroyitem([serial, memo], {from: testAccount2});
+
+        //assert purges table values
+        let purgesTable = await marbleContract.provider.select('purges').from('mbl').equal(serial).find();
+        assert(purgesTable.length == 1, "Item Not Queued for Purge");
+
+        //call purgeitem() on marble contract
+        const res = await marbleContract.actions.purgeitem([serial, 10], {from: testAccount3});
+        assert(res.processed.receipt.status == 'executed', "purgeitem() action was not executed");
+
+        //assert layer tables values
+        const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).find();
+        assert(tagsTable.length == 0, "Tags Not Purged");
+        const attrsTable = await marbleContract.provider.select('attributes').from('mbl').scope(serial).find();
+        assert(attrsTable.length == 0, "Attributes Not Purged");
+
+        //assert purges table values
+        purgesTable = await marbleContract.provider.select('purges').from('mbl').equal(serial).find();
+        assert(purgesTable.length == 0, "Purge Not Removed");
+    });
+
+    it("Quick Build Items for Multiple Recipients", async () => {
+        //initialize
+        const frameName = "mage";
+        const groupName = "heroes";
+        const recipients = [testAccount1.name, testAccount3.name];
+        const firstSerial = 16;
+        const tagName = "school";
+        const tagContent = "fire";
+        const attrName = "mana";
+        const attrPoints = 10;
+
+        let defaultTags = [];
+        defaultTags.push( {key: tagName, value: tagContent} );
+
+        let defaultAttrs = [];
+        defaultAttrs.push( {key: attrName, value: attrPoints} );
+
+        //call newframe() on marble contract
+        await marbleContract.actions.newframe([frameName, groupName, defaultTags, defaultAttrs], {from: testAccount2});
+
+        //call quickbuildn() on marble contract
+        const res = await marbleContract.actions.quickbuildn([frameName, recipients, [], []], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "quickbuildn() action was not executed");
+
+        //assert items table values
+        const itemsTable = await marbleContract.provider.select('items').from('mbl').range(firstSerial, firstSerial + 1).limit(2).find();
+        assert(itemsTable[0].owner == recipients[0], "Incorrect Item Owner");
+        assert(itemsTable[1].owner == recipients[1], "Incorrect Item Owner");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].supply == 10, "Incorrect Supply");
+        assert(groupsTable[0].issued_supply == 17, "Incorrect Issued Supply");
+
+        //assert tags and attributes table values
+        const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(firstSerial + 1).equal(tagName).find();
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Tag Content");
+        const attrsTable = await marbleContract.provider.select('attributes').from('mbl').scope(firstSerial + 1).equal(attrName).find();
+        assert(attrsTable[0].points == attrPoints, "Incorrect Attribute Points");
+    });
+
+    it("Quick Build Item from Inherited Frame", async () => {
+        //initialize
+        const frameName = "mage";
+        const toAccount = testAccount1.name;
+        const serial = 18;
+        const attrName = "mana";
+        const attrPoints = 12;
+
+        let overrideAttrs = [];
+        overrideAttrs.push( {key: attrName, value: attrPoints} );
+
+        //call inheritframe() on marble contract
+        const res = await marbleContract.actions.inheritframe([frameName], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "inheritframe() action was not executed");
+
+        //assert frames table values
+        const framesTable = await marbleContract.provider.select('frames').from('mbl').equal(frameName).find();
+        assert(framesTable[0].inherit == true, "Incorrect Frame Inherit State");
+
+        //call quickbuild() on marble contract
+        await marbleContract.actions.quickbuild([frameName, toAccount, [], overrideAttrs], {from: testAccount2});
+
+        //assert items table values
+        const itemsTable = await marbleContract.provider.select('items').from('mbl').equal(serial).find();
+        assert(itemsTable[0].frame == frameName, "Incorrect Item Frame");
+
+        //assert only diverging values are written
+        const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).find();
+        assert(tagsTable.length == 0, "Inherited Tag Was Copied");
+        const attrsTable = await marbleContract.provider.select('attributes').from('mbl').scope(serial).equal(attrName).find();
+        assert(attrsTable[0].points == attrPoints, "Incorrect Attribute Points");
+    });
+
+    it("Share Tag Content Blob", async () => {
+        //initialize
+        const serial = 3;
+        const sharingSerial = 16;
+        const tagName = "school";
+        const tagContent = "fire";
+        const tagChecksum = crypto.createHash('sha256').update(tagContent).digest('hex');
+        const tagAlgo = "sha256-content";
+
+        //call newtag() on marble contract
+        const res = await marbleContract.actions.newtag([serial, tagName, tagContent, tagChecksum, tagAlgo, 0], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "newtag() action was not executed");
+
+        //assert tag points at existing blob
+        const tagsTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal(tagName).find();
+        const sharingTagsTable = await marbleContract.provider.select('tags').from('mbl').scope(sharingSerial).equal(tagName).find();
+        assert(tagsTable[0].blob_id == sharingTagsTable[0].blob_id, "Incorrect Tag Blob");
+        assert(tagsTable[0].checksum == tagChecksum, "Incorrect Tag Checksum");
+
+        //assert blobs table values
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(tagsTable[0].blob_id).find();
+        assert(blobsTable[0].content == tagContent, "Incorrect Blob Content");
+        assert(blobsTable[0].refs == 3, "Incorrect Blob Refs");
+    });
+
+    it("Get Resolved Items", async () => {
+        //initialize
+        const serials = [3, 16, 18, 999];
+        const cursor = 0;
+        const serial = 18;
+        const groupName = "heroes";
+
+        //call newtag() and newattribute() on marble contract, add shared values under frame and item values
+        await marbleContract.actions.newtag([serial, "school", "ice", null, null, 1], {from: testAccount2});
+        await marbleContract.actions.newtag([serial, "motto", "onward", null, null, 1], {from: testAccount2});
+        await marbleContract.actions.newattribute([serial, "mana", 5, 1], {from: testAccount2});
+
+        //call getitems() on marble contract
+        const res = await marbleContract.actions.getitems([serials, cursor], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "getitems() action was not executed");
+
+        //assert returned page
+        const page = res.processed.action_traces[0].return_value_data;
+        assert(page.items.map(i => Number(i.serial)).join() == "3,16,18", "Incorrect Item Serials");
+        assert(page.next_cursor == 0, "Incorrect Next Cursor");
+
+        //assert item values override frame defaults which override shared values
+        const view = page.items[2];
+        assert(view.frame == "mage", "Incorrect Item Frame");
+        const school = view.tags.find(t => t.tag_name == "school");
+        assert(school.content == "fire" && school.shared == false, "Frame Default Did Not Override Shared Tag");
+        const motto = view.tags.find(t => t.tag_name == "motto");
+        assert(motto.content == "onward" && motto.shared == true, "Incorrect Shared Tag");
+        const mana = view.attributes.find(a => a.attribute_name == "mana");
+        assert(mana.points == 12 && mana.shared == false, "Item Value Did Not Override Frame Default");
+
+        //call rmvtag() and rmvattribute() on marble contract, remove shared values
+        await marbleContract.actions.rmvtag([serial, groupName, "school", "", 1], {from: testAccount2});
+        await marbleContract.actions.rmvtag([serial, groupName, "motto", "", 1], {from: testAccount2});
+        await marbleContract.actions.rmvattribute([serial, groupName, "mana", 1], {from: testAccount2});
+    });
+
+    it("Set Multiple Tags", async () => {
+        //initialize
+        const serial = 3;
+        const ops = [
+            {op: "create", tag_name: "rarity", content: "common", checksum: null, algorithm: null},
+            {op: "create", tag_name: "title", content: "hero", checksum: null, algorithm: null},
+            {op: "update", tag_name: "rarity", content: "rare", checksum: null, algorithm: null},
+            {op: "lock", tag_name: "title", content: "", checksum: null, algorithm: null},
+        ];
+
+        //call settags() on marble contract
+        const res = await marbleContract.actions.settags([serial, ops, 0], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "settags() action was not executed");
+
+        //assert tags table values
+        const rarityTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal("rarity").find();
+        const blobsTable = await marbleContract.provider.select('blobs').from('mbl').equal(rarityTable[0].blob_id).find();
+        assert(blobsTable[0].content == "rare", "Incorrect Tag Content");
+        const titleTable = await marbleContract.provider.select('tags').from('mbl').scope(serial).equal("title").find();
+        assert(titleTable[0].locked == true, "Incorrect Tag Locked State");
+    });
+
+    it("Set Packed Attribute Mode", async () => {
+        //initialize
+        const groupTitle = "Marble Packed";
+        const groupDesc = "A collection storing packed attributes";
+        const groupName = "packed";
+        const groupSupplyCap = 100;
+
+        //call newgroup() on marble contract
+        const res = await marbleContract.actions.newgroup([groupTitle, groupDesc, groupName, testAccount2.name, groupSupplyCap], {from: adminAccount});
+        assert(res.processed.receipt.status == 'executed', "newgroup() action was not executed");
+
+        //call setattrmode() on marble contract
+        const res2 = await marbleContract.actions.setattrmode([groupName, 1], {from: testAccount2});
+        assert(res2.processed.receipt.status == 'executed', "setattrmode() action was not executed");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].options == 1, "Incorrect Group Options");
+    });
+
+    it("Compare Attribute RAM Per Item", async () => {
+        //initialize
+        const rowSerial = 19;
+        const packedSerial = 10001;
+        const attrNames = "abcdefghijklmnopqrst".split("").map(c => "stat" + c);
+
+        //call mintitem() on marble contract for each layout
+        await marbleContract.actions.mintitem([testAccount1.name, "heroes"], {from: testAccount2});
+        await marbleContract.actions.mintitem([testAccount1.name, "packed"], {from: testAccount2});
+
+        //add attributes in row layout
+        const rowRamBefore = (await marbleContract.provider.rpc.get_account(marbleAccount.name)).ram_usage;
+        for (let i = 0; i < attrNames.length; i++) {
+            await marbleContract.actions.newattribute([rowSerial, attrNames[i], i, 0], {from: testAccount2});
+        }
+        const rowRam = (await marbleContract.provider.rpc.get_account(marbleAccount.name)).ram_usage - rowRamBefore;
+
+        //add attributes in packed layout
+        const packedRamBefore = (await marbleContract.provider.rpc.get_account(marbleAccount.name)).ram_usage;
+        for (let i = 0; i < attrNames.length; i++) {
+            await marbleContract.actions.newattribute([packedSerial, attrNames[i], i, 0], {from: testAccount2});
+        }
+        const packedRam = (await marbleContract.provider.rpc.get_account(marbleAccount.name)).ram_usage - packedRamBefore;
+
+        //assert attribute packs table values
+        const packsTable = await marbleContract.provider.select('attrpacks').from('mbl').equal(packedSerial).find();
+        assert(packsTable[0].attributes.length == attrNames.length, "Incorrect Packed Attributes");
+
+        //assert ram usage
+        console.log("      attribute ram per item (20 attributes): rows", rowRam, "bytes, packed", packedRam, "bytes");
+        assert(packedRam < rowRam, "Packed Attributes Use More RAM");
+    });
+
+    it("Apply Attribute Deltas", async () => {
+        //initialize
+        const rowSerial = 19;
+        const packedSerial = 10001;
+        const deltas = [
+            {serial: rowSerial, attribute_name: "stata", delta: 5, shared: 0},
+            {serial: rowSerial, attribute_name: "stata", delta: -2, shared: 0},
+            {serial: packedSerial, attribute_name: "statb", delta: 10, shared: 0},
+            {serial: packedSerial, attribute_name: "statc", delta: -3, shared: 0},
+        ];
+
+        //call applydeltas() on marble contract
+        const res = await marbleContract.actions.applydeltas([deltas], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "applydeltas() action was not executed");
+
+        //assert attributes table values
+        const attributesTable = await marbleContract.provider.select('attributes').from('mbl').scope(rowSerial).equal("stata").find();
+        assert(attributesTable[0].points == 3, "Incorrect Attribute Points");
+
+        //assert attribute packs table values
+        const packsTable = await marbleContract.provider.select('attrpacks').from('mbl').equal(packedSerial).find();
+        const packed = packsTable[0].attributes;
+        assert(packed.find(a => a.attribute_name == "statb").points == 11, "Incorrect Packed Attribute Points");
+        assert(packed.find(a => a.attribute_name == "statc").points == -1, "Incorrect Packed Attribute Points");
+    });
+
+    it("Rank Attribute", async () => {
+        //initialize
+        const groupName = "heroes";
+        const attrName = "stata";
+        const serial = 19;
+        const newPoints = 50;
+
+        //call rankattr() on marble contract
+        const res = await marbleContract.actions.rankattr([groupName, attrName], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "rankattr() action was not executed");
+
+        //call setpoints() on marble contract
+        await marbleContract.actions.setpoints([serial, attrName, newPoints, 0], {from: testAccount2});
+
+        //assert ranks table values
+        const ranksTable = await marbleContract.provider.select('ranks').from('mbl').scope(groupName).find();
+        assert(ranksTable.length == 1, "Incorrect Ranks");
+        assert(ranksTable[0].serial == serial, "Incorrect Rank Serial");
+        assert(ranksTable[0].points == newPoints, "Incorrect Rank Points");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].options == 2, "Incorrect Group Options");
+    });
+
+    it("Sync and Get Ranks", async () => {
+        //initialize
+        const groupName = "packed";
+        const attrName = "statb";
+        const serial = 10001;
+
+        //call rankattr() and syncranks() on marble contract
+        await marbleContract.actions.rankattr([groupName, attrName], {from: testAccount2});
+        const res = await marbleContract.actions.syncranks([groupName, attrName, [serial]], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "syncranks() action was not executed");
+
+        //assert ranks table values
+        const ranksTable = await marbleContract.provider.select('ranks').from('mbl').scope(groupName).find();
+        assert(ranksTable[0].serial == serial, "Incorrect Rank Serial");
+        assert(ranksTable[0].points == 11, "Incorrect Rank Points");
+
+        //call getranks() on marble contract
+        const res2 = await marbleContract.actions.getranks([groupName, attrName, 0, 100, 10], {from: testAccount1});
+        assert(res2.processed.receipt.status == 'executed', "getranks() action was not executed");
+
+        //assert returned ranks
+        const entries = res2.processed.action_traces[0].return_value_data;
+        assert(entries.map(e => e.serial + ":" + e.points).join() == "10001:11", "Incorrect Ranked Entries");
+    });
+
+    it("Rank Inherited Frame Attributes", async () => {
+        //initialize
+        const groupName = "heroes";
+        const attrName = "mana";
+        const serial = 16;
+        const inheritingSerial = 18;
+        const newPoints = 20;
+
+        //call rankattr() and syncranks() on marble contract
+        await marbleContract.actions.rankattr([groupName, attrName], {from: testAccount2});
+        await marbleContract.actions.syncranks([groupName, attrName, [serial, inheritingSerial]], {from: testAccount1});
+
+        //call setpoints() on marble contract
+        await marbleContract.actions.setpoints([serial, attrName, newPoints, 0], {from: testAccount2});
+
+        //call rmvattribute() on marble contract, item falls back to frame default
+        await marbleContract.actions.rmvattribute([inheritingSerial, groupName, attrName, 0], {from: testAccount2});
+
+        //call getranks() on marble contract
+        const res = await marbleContract.actions.getranks([groupName, attrName, 0, 100, 10], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "getranks() action was not executed");
+
+        //assert returned ranks are ordered by points, including inherited points
+        const entries = res.processed.action_traces[0].return_value_data;
+        assert(entries.map(e => e.serial + ":" + e.points).join() == "16:20,18:10", "Incorrect Ranked Entries");
+    });
+
+    it("Set Emission Mode", async () => {
+        //initialize
+        const groupName = "heroes";
+
+        //call setemitmode() on marble contract
+        const res = await marbleContract.actions.setemitmode([groupName, "off"], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "setemitmode() action was not executed");
+
+        //assert groups table values
+        const groupsTable = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable[0].options == 10, "Incorrect Group Options");
+
+        //call mintitem() on marble contract, assert no events emitted
+        const res2 = await marbleContract.actions.mintitem([testAccount1.name, groupName], {from: testAccount2});
+        assert(res2.processed.action_traces[0].inline_traces.length == 0, "Event Emitted While Off");
+
+        //call setemitmode() on marble contract
+        await marbleContract.actions.setemitmode([groupName, "aggregate"], {from: testAccount2});
+
+        //assert groups table values
+        const groupsTable2 = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable2[0].options == 6, "Incorrect Group Options");
+
+        //call mintitem() on marble contract, assert one logrange emitted
+        const res3 = await marbleContract.actions.mintitem([testAccount1.name, groupName], {from: testAccount2});
+        const traces = res3.processed.action_traces[0].inline_traces;
+        assert(traces.length == 1 && traces[0].act.name == "logrange", "Aggregate Event Not Emitted");
+
+        //call setemitmode() on marble contract, back to default inline mode
+        await marbleContract.actions.setemitmode([groupName, "inline"], {from: testAccount2});
+
+        //assert groups table values
+        const groupsTable3 = await marbleContract.provider.select('groups').from('mbl').find(groupName);
+        assert(groupsTable3[0].options == 2, "Incorrect Group Options");
+    });
+
+    //======================== wallet tests ========================
+
+    it("Register Currency", async () => {
+        //initialize
+        const currencySym = "4,GAME";
+        const currencyCode = "GAME";
+
+        //call newcurrency() on marble contract
+        const res = await marbleContract.actions.newcurrency([currencySym, testAccount1.name], {from: adminAccount});
+        assert(res.processed.receipt.status == 'executed', "newcurrency() action was not executed");
+
+        //assert currencies table values
+        const currenciesTable = await marbleContract.provider.select('currencies').from('mbl').find();
+        const curr = currenciesTable.find(c => c.total_deposits == "0.0000 GAME");
+        assert(curr != undefined, "Currency Not Found");
+        assert(curr.home_contract == testAccount1.name, "Incorrect Home Contract");
+        assert(curr.approved == 1, "Incorrect Currency Approval");
+
+        //call synccurrency() on marble contract
+        const res2 = await marbleContract.actions.synccurrency(["5.0000 GAME", 2, 1, testAccount1.name], {from: adminAccount});
+        assert(res2.processed.receipt.status == 'executed', "synccurrency() action was not executed");
+
+        //assert currencies table values
+        const currenciesTable2 = await marbleContract.provider.select('currencies').from('mbl').find();
+        const synced = currenciesTable2.find(c => c.total_deposits == "5.0000 GAME");
+        assert(synced != undefined, "Incorrect Currency Deposits");
+        assert(synced.total_wallets == 2, "Incorrect Currency Wallets");
+        assert(synced.total_bonds == 1, "Incorrect Currency Bonds");
+
+        //call synccurrency() on marble contract, reset totals
+        await marbleContract.actions.synccurrency(["0.0000 GAME", 0, 0, testAccount1.name], {from: adminAccount});
+
+        //call setcurrency() on marble contract
+        const res3 = await marbleContract.actions.setcurrency([currencyCode, false], {from: adminAccount});
+        assert(res3.processed.receipt.status == 'executed', "setcurrency() action was not executed");
+
+        //assert currencies table values
+        const currenciesTable3 = await marbleContract.provider.select('currencies').from('mbl').find();
+        assert(currenciesTable3.find(c => c.total_deposits == "0.0000 GAME").approved == 0, "Incorrect Currency Approval");
+
+        //call rmvcurrency() on marble contract
+        const res4 = await marbleContract.actions.rmvcurrency([currencyCode], {from: adminAccount});
+        assert(res4.processed.receipt.status == 'executed', "rmvcurrency() action was not executed");
+
+        //assert currencies table values
+        const currenciesTable4 = await marbleContract.provider.select('currencies').from('mbl').find();
+        assert(currenciesTable4.find(c => c.total_deposits == "0.0000 GAME") == undefined, "Currency Not Removed");
+    });
+
+    //======================== bond release tests ========================
+
+    it("Deposit to Wallet", async () => {
+        //initialize
+        const amount = "100.0000 TLOS";
+
+        //fund manager account from eosio
+        eosioAccount = eoslime.Account.load("eosio", EOSIO_PRIVATE_KEY);
+        tokenContract = await eoslime.Contract.at("eosio.token");
+        await tokenContract.actions.transfer([eosioAccount.name, testAccount2.name, amount, ""], {from: eosioAccount});
+
+        //call transfer() on eosio.token with deposit memo
+        const res = await tokenContract.actions.transfer([testAccount2.name, marbleAccount.name, amount, "deposit"], {from: testAccount2});
+        assert(res.processed.receipt.status == 'executed', "transfer() action was not executed");
+
+        //assert wallets table values
+        const walletsTable = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount2.name).find();
+        assert(walletsTable[0].balance == amount, "Incorrect Wallet Balance");
+
+        //assert currencies table values
+        const currenciesTable = await marbleContract.provider.select('currencies').from('mbl').find();
+        const curr = currenciesTable.find(c => c.home_contract == "eosio.token");
+        assert(curr.total_deposits == amount, "Incorrect Currency Deposits");
+        assert(curr.total_wallets == 1, "Incorrect Currency Wallets");
+    });
+
+    it("Crank Bond Releases in Time Order", async () => {
+        //initialize
+        const eventName = "unlock";
+        const laterSerial = 16;
+        const earlierSerial = 18;
+        const laterTime = new Date(Date.now() + 5000).toISOString().slice(0, 19);
+        const earlierTime = new Date(Date.now() + 3000).toISOString().slice(0, 19);
+
+        //call newevent() and newbond() on marble contract for each item
+        await marbleContract.actions.newevent([laterSerial, eventName, laterTime, 0], {from: testAccount2});
+        await marbleContract.actions.newevent([earlierSerial, eventName, earlierTime, 0], {from: testAccount2});
+        await marbleContract.actions.newbond([laterSerial, "10.0000 TLOS", eventName], {from: testAccount2});
+        await marbleContract.actions.newbond([earlierSerial, "5.0000 TLOS", eventName], {from: testAccount2});
+
+        //assert releases table values
+        const releasesTable = await marbleContract.provider.select('releases').from('mbl').find();
+        assert(releasesTable.length == 2, "Incorrect Release Count");
+
+        //wait for both release times
+        await new Promise(resolve => setTimeout(resolve, 6000));
+
+        //call crank() on marble contract, release one bond
+        const res = await marbleContract.actions.crank([1], {from: testAccount3});
+        assert(res.processed.receipt.status == 'executed', "crank() action was not executed");
+
+        //assert earliest release processed first
+        const earlierBonds = await marbleContract.provider.select('bonds').from('mbl').scope(earlierSerial).find();
+        assert(earlierBonds.length == 0, "Earliest Bond Not Released");
+        const laterBonds = await marbleContract.provider.select('bonds').from('mbl').scope(laterSerial).find();
+        assert(laterBonds.length == 1, "Crank Exceeded Batch Limit");
+
+        //assert wallets table values
+        const walletsTable = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount1.name).find();
+        assert(walletsTable[0].balance == "5.0000 TLOS", "Incorrect Wallet Balance");
+
+        //call crank() on marble contract, release remaining bond
+        await marbleContract.actions.crank([10], {from: testAccount3});
+
+        //assert releases and wallets table values
+        const releasesTable2 = await marbleContract.provider.select('releases').from('mbl').find();
+        assert(releasesTable2.length == 0, "Releases Not Removed");
+        const walletsTable2 = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount1.name).find();
+        assert(walletsTable2[0].balance == "15.0000 TLOS", "Incorrect Wallet Balance");
+    });
+
+    it("Release Vested Bonds from Many Items", async () => {
+        //initialize
+        const serials = [16, 18];
+        const startTime = new Date(Date.now() - 10000).toISOString().slice(0, 19);
+
+        //call newvesting() on marble contract for each item
+        await marbleContract.actions.newvesting([serials[0], "4.0000 TLOS", 2, 1, startTime], {from: testAccount2});
+        await marbleContract.actions.newvesting([serials[1], "2.0000 TLOS", 2, 1, startTime], {from: testAccount2});
+
+        //call releasemany() on marble contract
+        const res = await marbleContract.actions.releasemany([testAccount1.name, serials], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "releasemany() action was not executed");
+
+        //assert bonds table values
+        for (const s of serials) {
+            const bondsTable = await marbleContract.provider.select('bonds').from('mbl').scope(s).find();
+            assert(bondsTable.length == 0, "Vested Bond Not Released");
+        }
+
+        //assert wallets table values
+        const walletsTable = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount1.name).find();
+        assert(walletsTable[0].balance == "21.0000 TLOS", "Incorrect Wallet Balance");
+
+        //assert currencies table values
+        const currenciesTable = await marbleContract.provider.select('currencies').from('mbl').find();
+        assert(currenciesTable.find(c => c.home_contract == "eosio.token").total_bonds == 0, "Incorrect Currency Bonds");
+    });
+
+    it("Pay Out to Many Recipients", async () => {
+        //initialize
+        const payments = [
+            {first: testAccount2.name, second: "1.0000 TLOS"},
+            {first: testAccount3.name, second: "2.0000 TLOS"},
+            {first: testAccount3.name, second: "3.0000 TLOS"},
+        ];
+
+        //call payout() on marble contract
+        const res = await marbleContract.actions.payout([testAccount1.name, payments], {from: testAccount1});
+        assert(res.processed.receipt.status == 'executed', "payout() action was not executed");
+
+        //assert payer debited once and recipients credited once per currency
+        const payerWallets = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount1.name).find();
+        assert(payerWallets[0].balance == "15.0000 TLOS", "Incorrect Payer Balance");
+        const managerWallets = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount2.name).find();
+        assert(managerWallets[0].balance == "80.0000 TLOS", "Incorrect Recipient Balance");
+        const recipientWallets = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount3.name).find();
+        assert(recipientWallets.length == 1 && recipientWallets[0].balance == "5.0000 TLOS", "Incorrect Recipient Balance");
+
+        //call withdraw() on marble contract, empty recipient wallet
+        await marbleContract.actions.withdraw([testAccount3.name, "5.0000 TLOS"], {from: testAccount3});
+
+        //assert wallets and currencies table values
+        const recipientWallets2 = await marbleContract.provider.select('wallets').from('mbl').scope(testAccount3.name).find();
+        assert(recipientWallets2.length == 0, "Emptied Wallet Not Removed");
+        const currenciesTable = await marbleContract.provider.select('currencies').from('mbl').find();
+        const curr = currenciesTable.find(c => c.home_contract == "eosio.token");
+        assert(curr.total_deposits == "95.0000 TLOS", "Incorrect Currency Deposits");
+        assert(curr.total_wallets == 2, "Incorrect Currency Wallets");
+    });
+
 });
\ No newline at end of file